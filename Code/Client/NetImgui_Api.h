@@ -128,6 +128,13 @@ enum eTexFormat {
 	// Search for TEXTURE_CUSTOM_SAMPLE for example implementation.
 	kTexFmtCustom,
 	
+	// Compressed transport formats, generated by the client before sending RGBA8/A8 textures
+	// to the server (see 'SetTextureCompression'). Not meant to be used with 'SendDataTexture'
+	kTexFmtRGBA8_LZ,		// Lossless (delta filter + LZ)
+	kTexFmtA8_LZ,			// Lossless (delta filter + LZ)
+	kTexFmtRGBA8_Block,		// Lossy (4x4 pixels blocks, 2 endpoints and 2bits per pixel, + LZ)
+	kTexFmtRGBA8_Video,		// Lossless inter-frame (8x8 pixels blocks predicted from previous content, + LZ)
+
 	//
 	kTexFmt_Count,
 	kTexFmt_Invalid=kTexFmt_Count 
@@ -142,11 +149,48 @@ enum eCompressionMode {
 	kUseServerSetting		// Use Server setting for compression (default)
 };
 
+//=================================================================================================
+// Texture data compression wanted status
+//=================================================================================================
+enum eTexCompression {
+	kTexCompressionNone,		// Send textures uncompressed
+	kTexCompressionLossless,	// Compress RGBA8/A8 textures without any quality loss (default)
+	kTexCompressionLossy,		// Compress RGBA8 user textures with small quality loss (Dear ImGui textures stay lossless)
+	kTexCompressionVideo,		// Lossless, with RGBA8 user textures sent again every frame (game viewport, video, ...) only transmitting their difference with the previous content
+};
+
+//=================================================================================================
+// Texture data kept by the client, after sending it to the server (needed to resend it on reconnect)
+//=================================================================================================
+enum eTexRetention {
+	kTexRetentionCopy,			// Keep a copy of the texture pixels (default). Needed to only send the modified areas of an updated texture
+	kTexRetentionCompressed,	// Keep a lossless compressed copy of the texture pixels
+	kTexRetentionNone,			// Keep no pixels. User is asked to send the texture again with 'SendDataTexture', when needed
+};
+
+//=================================================================================================
+// Precision of the vertices position sent to the server
+//=================================================================================================
+enum eVertexPrecision {
+	kVertexPrecisionAuto,		// Integer positions, with the finest precision fitting each window size (default). Float for very large windows
+	kVertexPrecisionFloat,		// Float positions. More data sent, but exact positions
+};
+
+//=================================================================================================
+// When a new frame should be drawn for the server
+//=================================================================================================
+enum eRedrawMode {
+	kRedrawContinuous,			// Draw at the refresh rate requested by the Server (default)
+	kRedrawOnChange,			// Only draw after input changes from the Server, a 'MarkDirty' call, or a long delay
+};
+
 //-------------------------------------------------------------------------------------------------
 // Function typedefs
 //-------------------------------------------------------------------------------------------------
 typedef void (*ThreadFunctPtr)(void threadedFunction(void* pClientInfo), void* pClientInfo);
 typedef void (*FontCreateFuncPtr)(float PreviousDPIScale, float NewDPIScale);
+typedef void (*TextureRefetchFuncPtr)(ImTextureID textureId);	// Must call 'SendDataTexture' with the texture content
+typedef void (*TextureSentFuncPtr)(ImTextureID textureId, void* pUserData);	// User texture buffer isn't needed by NetImgui anymore
 
 //=================================================================================================
 // Initialize the Network Library
@@ -219,12 +263,26 @@ NETIMGUI_API	bool				IsDrawingRemote(void);
 // Note: Can now rely on native Dear ImGui managed texture support to let the system handle their
 //		 creation/update/destruction automatically, without needing to call this function
 //		 (since Dear ImGui 1.92+. See 'SampleTextures').
+// Note: Sending again a texture with the same size and format, only transmits its modified areas
 //=================================================================================================
 NETIMGUI_API	void				SendDataTexture(ImTextureID textureId, void* pData, uint16_t width, uint16_t height, eTexFormat format, uint32_t dataSize=0);
 #if NETIMGUI_IMGUI_TEXTURES_ENABLED
 NETIMGUI_API	void				SendDataTexture(const ImTextureRef& textureRef, void* pData, uint16_t width, uint16_t height, eTexFormat format, uint32_t dataSize=0);
 #endif
 
+//=================================================================================================
+// Send a texture used by imgui, to the NetImguiServer application, without copying its content.
+// The pixel data is transmitted directly from the user buffer, which must stay valid and unmodified
+// until 'sentFunction' is called. Can be called from any thread.
+// Note: 'sentFunction' is always called once per request, from the communication thread when the 
+//		 texture has been sent, or from the calling/main thread when it cannot be sent
+// Note: Request is processed during the next 'NetImgui::EndFrame', replacing the previous content
+//		 of the texture. To remove the texture, use 'SendDataTexture' with pData set to nullptr
+// Note: Texture is sent uncompressed and the client keeps none of its pixels afterward. Use 
+//		 'SetTextureRetention' refetch function to send it again after a reconnect
+//=================================================================================================
+NETIMGUI_API	void				SendDataTextureAsync(ImTextureID textureId, const void* pData, uint16_t width, uint16_t height, eTexFormat format, TextureSentFuncPtr sentFunction, void* pUserData=nullptr, uint32_t dataSize=0);
+
 //=================================================================================================
 // Start a new Imgui Frame and wait for Draws commands, using ImContext that was active on connect.
 // Returns true if we are awaiting a new ImGui frame. 
@@ -270,6 +328,75 @@ NETIMGUI_API	void				SetBackground(const ImVec4& bgColor, const ImVec4& textureT
 NETIMGUI_API	void				SetCompressionMode(eCompressionMode eMode);
 NETIMGUI_API	eCompressionMode	GetCompressionMode();
 
+//=================================================================================================
+// Control the compression applied to textures sent to the Server
+// Note: Compression is done in the communication thread, when the texture is being sent
+// Note: With 'kTexCompressionVideo', the communication thread and the Server both keep an extra
+//		 copy of each texture streamed this way (previous content needed by the next frame)
+//=================================================================================================
+NETIMGUI_API	void				SetTextureCompression(eTexCompression eCompression);
+NETIMGUI_API	eTexCompression		GetTextureCompression();
+
+//=================================================================================================
+// Control how much of the user textures content is kept by the client, once sent to the Server.
+// By default, a copy of every texture sent with 'SendDataTexture' is kept for the entire session.
+// Note: Only applies to textures sent after this call, Dear ImGui managed textures are not affected
+// Note: Textures not keeping an uncompressed copy are always entirely sent again when updated
+// Note: With 'kTexRetentionNone', 'refetchFunction' is called when the texture content is needed
+//		 again (on reconnect, ...). Without it, these textures won't be displayed after a reconnect
+//=================================================================================================
+NETIMGUI_API	void				SetTextureRetention(eTexRetention eRetention, TextureRefetchFuncPtr refetchFunction=nullptr);
+NETIMGUI_API	eTexRetention		GetTextureRetention();
+
+//=================================================================================================
+// Control the precision of the vertices position sent to the Server
+// Note: With 'kVertexPrecisionAuto', positions have at least 1/4 pixel precision
+//=================================================================================================
+NETIMGUI_API	void				SetVertexPrecision(eVertexPrecision ePrecision);
+NETIMGUI_API	eVertexPrecision	GetVertexPrecision();
+
+//=================================================================================================
+// Let small vertices changes between frames be ignored, keeping the previous values instead
+// Reduces the data sent for animated but visually static content (sub pixel jitter, ...)
+// 'positionThreshold' : Position changes under this value (in pixels) are ignored
+// 'colorThreshold'    : Color changes with every channel under this value (0-255) are ignored
+// Note: Disabled by default (0 values). Exact content is still sent every few frames
+//=================================================================================================
+NETIMGUI_API	void				SetChangeThreshold(float positionThreshold, uint8_t colorThreshold);
+NETIMGUI_API	float				GetChangeThresholdPosition();
+NETIMGUI_API	uint8_t				GetChangeThresholdColor();
+
+//=================================================================================================
+// Limit how often the content of a Dear ImGui window (and its child windows) is updated on the 
+// Server. Until 'updateInterval' elapsed, the window content last sent is sent again instead,
+// costing almost nothing with delta compression. Useful for slow changing content (stats, ...)
+// 'windowName'     : Name of the window, as used with 'ImGui::Begin()'
+// 'updateInterval' : Minimum time between updates (in seconds). 0 removes the limit (default)
+// Note: Windows hovered or focused are always updated, to keep interactions responsive
+// Note: Call from the thread drawing the Dear ImGui content
+//=================================================================================================
+NETIMGUI_API	void				SetWindowUpdateInterval(const char* windowName, float updateInterval);
+NETIMGUI_API	float				GetWindowUpdateInterval(const char* windowName);
+
+//=================================================================================================
+// Control when new frames are drawn for the Server (see 'eRedrawMode')
+// With 'kRedrawOnChange', an idle UI stops being drawn, converted and sent entirely. Frames are 
+// still drawn for a short moment after each input change (to let animations, hovering, ... 
+// settle), and at least every 'heartbeatInterval' seconds (0 disables it).
+// Note: Content changing without user input (stats, logs, ...) should call 'MarkDirty' to be 
+//		 displayed sooner than the heartbeat
+// Note: Frames are only skipped by 'NewFrame(bSupportFrameSkip=true)', otherwise
+//		 they are still drawn, but not converted and sent to the Server
+//=================================================================================================
+NETIMGUI_API	void				SetRedrawMode(eRedrawMode eMode, float heartbeatInterval=1.f);
+NETIMGUI_API	eRedrawMode			GetRedrawMode();
+NETIMGUI_API	void				MarkDirty();	// Request a new frame to be drawn (with 'kRedrawOnChange'). Thread safe
+
+//=================================================================================================
+// Memory used by the client to keep track of the textures sent to the Server (in bytes)
+//=================================================================================================
+NETIMGUI_API	uint64_t			GetTextureMemoryUsage();
+
 //=================================================================================================
 // Helper functions
 //=================================================================================================
@@ -288,6 +415,7 @@ NETIMGUI_API	uint32_t			GetTexture_BytePerImage	(eTexFormat eFormat, uint32_t pi
 	#include "Private/NetImgui_Api.cpp"
 	#include "Private/NetImgui_Client.cpp"
 	#include "Private/NetImgui_CmdPackets_DrawFrame.cpp"
+	#include "Private/NetImgui_CmdPackets_Texture.cpp"
 	#include "Private/NetImgui_NetworkPosix.cpp"
 	#include "Private/NetImgui_NetworkUE4.cpp"
 	#include "Private/NetImgui_NetworkWin32.cpp"
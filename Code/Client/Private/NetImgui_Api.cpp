@@ -210,7 +210,18 @@ bool NewFrame(bool bSupportFrameSkip)
 		client.mbValidDrawFrame				= false;
 		
 		// Take into account delay until next method call, for more precise fps
-		if( client.mDesiredFps > 0.f && (elapsedDrawMs + elapsedCheckMs/2.f) > (1000.f/client.mDesiredFps) )
+		bool bRedraw						= client.mDesiredFps > 0.f && (elapsedDrawMs + elapsedCheckMs/2.f) > (1000.f/client.mDesiredFps);
+
+		// Only draw after a change when requested, letting an idle UI cost nothing (see 'SetRedrawMode')
+		if( bRedraw && client.mRedrawMode == eRedrawMode::kRedrawOnChange )
+		{
+			if( client.mbRedrawPending.exchange(false) ){
+				client.mRedrawSettleTime	= client.mLastOutgoingDrawCheckTime + std::chrono::microseconds(static_cast<int64_t>(Client::ClientInfo::kRedrawSettleTime * 1000000.f));
+			}
+			bRedraw							= client.mLastOutgoingDrawCheckTime < client.mRedrawSettleTime || (client.mRedrawHeartbeat > 0.f && elapsedDrawMs >= client.mRedrawHeartbeat * 1000.f);
+		}
+
+		if( bRedraw )
 		{
 			client.mLastOutgoingDrawTime	= std::chrono::steady_clock::now();
 			client.mbValidDrawFrame			= true;
@@ -357,15 +368,21 @@ void SendDataTexture(ImTextureID textureId, void* pData, uint16_t width, uint16_
 	// Add/Update a texture
 	if( pData != nullptr )
 	{
-		CmdTexture* pCmdTexture	= client.TextureCmdAllocate(clientTexID, width, height, format, dataSize);
+		// Texture already on Server, only send the modified areas
+		const bool bUpdated		= client.TextureTrackingUpdateData(clientTexID, pData, width, height, format);
+		CmdTexture* pCmdTexture	= bUpdated ? nullptr : client.TextureCmdAllocate(clientTexID, width, height, format, dataSize);
 		if( pCmdTexture )
 		{
 			memcpy(pCmdTexture->mpTextureData.Get(), pData, dataSize);
+			pCmdTexture->mUpdatable	= format != eTexFormat::kTexFmtCustom && client.TextureTrackingFind(clientTexID) != nullptr; // Content refreshed by user, allow partial updates from now on
 			pCmdTexture->mpTextureData.ToOffset();
 			client.TextureTrackingAdd(*pCmdTexture);
+		}
 
-			// Detects when user is sending the font texture
-		#if !NETIMGUI_IMGUI_TEXTURES_ENABLED
+		// Detects when user is sending the font texture
+	#if !NETIMGUI_IMGUI_TEXTURES_ENABLED
+		if( bUpdated || pCmdTexture )
+		{
 			ScopedImguiContext scopedCtx(client.mpContext ? client.mpContext : ImGui::GetCurrentContext());
 			if( ImGui::GetIO().Fonts && ImGui::GetIO().Fonts->TexID == textureId )
 			{
@@ -373,8 +390,8 @@ void SendDataTexture(ImTextureID textureId, void* pData, uint16_t width, uint16_
 				client.mpFontTextureData	= ImGui::GetIO().Fonts->TexPixelsAlpha8;
 				client.mFontTextureID		= clientTexID;
 			}
-		#endif
 		}
+	#endif
 	}
 	// Texture to remove
 	else
@@ -395,10 +412,16 @@ void SendDataTexture(const ImTextureRef& textureRef, void* pData, uint16_t width
 	// Add/Update a texture
 	if( pData != nullptr )
 	{
+		// Texture already on Server, only send the modified areas
+		if( client.TextureTrackingUpdateData(clientTexID, pData, width, height, format) ){
+			return;
+		}
+
 		CmdTexture* pCmdTexture	= client.TextureCmdAllocate(clientTexID, width, height, format, dataSize);
 		if( pCmdTexture )
 		{
 			memcpy(pCmdTexture->mpTextureData.Get(), pData, dataSize);
+			pCmdTexture->mUpdatable	= format != eTexFormat::kTexFmtCustom && client.TextureTrackingFind(clientTexID) != nullptr; // Content refreshed by user, allow partial updates from now on
 			pCmdTexture->mpTextureData.ToOffset();
 			client.TextureTrackingAdd(*pCmdTexture);
 		}
@@ -411,6 +434,19 @@ void SendDataTexture(const ImTextureRef& textureRef, void* pData, uint16_t width
 }
 #endif //NETIMGUI_IMGUI_TEXTURES_ENABLED
 
+//=================================================================================================
+void SendDataTextureAsync(ImTextureID textureId, const void* pData, uint16_t width, uint16_t height, eTexFormat format, TextureSentFuncPtr sentFunction, void* pUserData, uint32_t dataSize)
+//=================================================================================================
+{
+	CmdTexture* pCmdTexture = gpClientInfo && pData ? Client::CmdTextureBorrowed::Allocate(ConvertToClientTexID(textureId), pData, width, height, format, dataSize, sentFunction, pUserData) : nullptr;
+	if( pCmdTexture ){
+		gpClientInfo->TextureTrackingAddAsync(*pCmdTexture);
+	}
+	else if( sentFunction ){
+		sentFunction(textureId, pUserData); // Nothing to send, buffer can be released right away
+	}
+}
+
 //=================================================================================================
 void SetBackground(const ImVec4& bgColor)
 //=================================================================================================
@@ -492,6 +528,187 @@ eCompressionMode GetCompressionMode()
 	return static_cast<eCompressionMode>(client.mClientCompressionMode);
 }
 
+//=================================================================================================
+void SetTextureCompression(eTexCompression eCompression)
+//=================================================================================================
+{
+	if (!gpClientInfo) return;
+	
+	Client::ClientInfo& client		= *gpClientInfo;
+	client.mTextureCompression		= static_cast<uint8_t>(eCompression);
+}
+
+//=================================================================================================
+eTexCompression GetTextureCompression()
+//=================================================================================================
+{
+	if (!gpClientInfo) return eTexCompression::kTexCompressionLossless;
+	
+	Client::ClientInfo& client	= *gpClientInfo;
+	return static_cast<eTexCompression>(client.mTextureCompression);
+}
+
+//=================================================================================================
+void SetTextureRetention(eTexRetention eRetention, TextureRefetchFuncPtr refetchFunction)
+//=================================================================================================
+{
+	if (!gpClientInfo) return;
+	
+	Client::ClientInfo& client			= *gpClientInfo;
+	client.mTextureRetention			= static_cast<uint8_t>(eRetention);
+	client.mTextureRefetchFunction		= refetchFunction;
+}
+
+//=================================================================================================
+eTexRetention GetTextureRetention()
+//=================================================================================================
+{
+	if (!gpClientInfo) return eTexRetention::kTexRetentionCopy;
+	
+	Client::ClientInfo& client	= *gpClientInfo;
+	return static_cast<eTexRetention>(client.mTextureRetention);
+}
+
+//=================================================================================================
+void SetVertexPrecision(eVertexPrecision ePrecision)
+//=================================================================================================
+{
+	if (!gpClientInfo) return;
+	
+	Client::ClientInfo& client		= *gpClientInfo;
+	client.mVertexPrecision			= static_cast<uint8_t>(ePrecision);
+}
+
+//=================================================================================================
+eVertexPrecision GetVertexPrecision()
+//=================================================================================================
+{
+	if (!gpClientInfo) return eVertexPrecision::kVertexPrecisionAuto;
+	
+	Client::ClientInfo& client	= *gpClientInfo;
+	return static_cast<eVertexPrecision>(client.mVertexPrecision);
+}
+
+//=================================================================================================
+void SetChangeThreshold(float positionThreshold, uint8_t colorThreshold)
+//=================================================================================================
+{
+	if (!gpClientInfo) return;
+	
+	Client::ClientInfo& client		= *gpClientInfo;
+	client.mChangeThresholdPos		= positionThreshold > 0.f ? positionThreshold : 0.f;
+	client.mChangeThresholdColor	= colorThreshold;
+}
+
+//=================================================================================================
+float GetChangeThresholdPosition()
+//=================================================================================================
+{
+	if (!gpClientInfo) return 0.f;
+	
+	Client::ClientInfo& client	= *gpClientInfo;
+	return client.mChangeThresholdPos;
+}
+
+//=================================================================================================
+uint8_t GetChangeThresholdColor()
+//=================================================================================================
+{
+	if (!gpClientInfo) return 0;
+	
+	Client::ClientInfo& client	= *gpClientInfo;
+	return client.mChangeThresholdColor;
+}
+
+//=================================================================================================
+void SetWindowUpdateInterval(const char* windowName, float updateInterval)
+//=================================================================================================
+{
+	if (!gpClientInfo || !windowName) return;
+
+	Client::ClientInfo& client	= *gpClientInfo;
+	const ImGuiID windowID		= ImHashStr(windowName);
+	for(int i = 0; i < client.mWindowThrottles.Size; ++i)
+	{
+		Client::ClientInfo::WindowThrottle& windowThrottle = client.mWindowThrottles[i];
+		if( windowThrottle.mWindowID == windowID ){
+			if( updateInterval > 0.f ){
+				windowThrottle.mUpdateInterval = updateInterval;
+			}
+			else {
+				Client::ClientInfo::WindowThrottleClear(windowThrottle);
+				client.mWindowThrottles.erase(&windowThrottle);
+			}
+			return;
+		}
+	}
+
+	if( updateInterval > 0.f ){
+		Client::ClientInfo::WindowThrottle windowThrottle;
+		windowThrottle.mWindowID		= windowID;
+		windowThrottle.mUpdateInterval	= updateInterval;
+		client.mWindowThrottles.push_back(windowThrottle);
+	}
+}
+
+//=================================================================================================
+float GetWindowUpdateInterval(const char* windowName)
+//=================================================================================================
+{
+	if (!gpClientInfo || !windowName) return 0.f;
+
+	Client::ClientInfo& client	= *gpClientInfo;
+	const ImGuiID windowID		= ImHashStr(windowName);
+	for(const auto& windowThrottle : client.mWindowThrottles){
+		if( windowThrottle.mWindowID == windowID ){
+			return windowThrottle.mUpdateInterval;
+		}
+	}
+	return 0.f;
+}
+
+//=================================================================================================
+void SetRedrawMode(eRedrawMode eMode, float heartbeatInterval)
+//=================================================================================================
+{
+	if (!gpClientInfo) return;
+
+	Client::ClientInfo& client	= *gpClientInfo;
+	client.mRedrawMode			= static_cast<uint8_t>(eMode);
+	client.mRedrawHeartbeat		= heartbeatInterval > 0.f ? heartbeatInterval : 0.f;
+	client.mbRedrawPending		= true;
+}
+
+//=================================================================================================
+eRedrawMode GetRedrawMode()
+//=================================================================================================
+{
+	if (!gpClientInfo) return eRedrawMode::kRedrawContinuous;
+
+	Client::ClientInfo& client	= *gpClientInfo;
+	return static_cast<eRedrawMode>(client.mRedrawMode);
+}
+
+//=================================================================================================
+void MarkDirty()
+//=================================================================================================
+{
+	if (!gpClientInfo) return;
+
+	Client::ClientInfo& client	= *gpClientInfo;
+	client.mbRedrawPending		= true;
+}
+
+//=================================================================================================
+uint64_t GetTextureMemoryUsage()
+//=================================================================================================
+{
+	if (!gpClientInfo) return 0;
+	
+	Client::ClientInfo& client	= *gpClientInfo;
+	return client.TextureTrackingMemoryUsage();
+}
+
 //=================================================================================================
 bool Startup(void)
 //=================================================================================================
@@ -553,6 +770,11 @@ uint8_t GetTexture_BitsPerPixel(eTexFormat eFormat)
 	case eTexFormat::kTexFmtA8:			return 8*1;
 	case eTexFormat::kTexFmtRGBA8:		return 8*4;
 	case eTexFormat::kTexFmtCustom:		return 0;
+	// Compressed transport formats have a content dependent size
+	case eTexFormat::kTexFmtRGBA8_LZ:
+	case eTexFormat::kTexFmtA8_LZ:
+	case eTexFormat::kTexFmtRGBA8_Block:
+	case eTexFormat::kTexFmtRGBA8_Video:return 0;
 	case eTexFormat::kTexFmt_Invalid:	return 0;
 	}
 	return 0;
@@ -114,6 +114,24 @@ static void SetClipboardTextFn_NetImguiImpl(ImGuiContext* ctx, const char* text)
 }
 #endif
 
+//=================================================================================================
+// Detect when the Server input differs from the previous one, requiring a redraw when the
+// client only draws on changes (see 'SetRedrawMode'). Acknowledged frame index is ignored.
+//=================================================================================================
+static bool IsInputChanged(const CmdInput& inputNew, const CmdInput& inputPrev)
+{
+	return	inputNew.mKeyCharCount > 0 || inputNew.mCompressionSkip || inputNew.mCompressionUse != inputPrev.mCompressionUse ||
+			inputNew.mMouseDownMask != inputPrev.mMouseDownMask ||
+			memcmp(inputNew.mScreenSize, inputPrev.mScreenSize, sizeof(inputNew.mScreenSize)) != 0 ||
+			memcmp(inputNew.mMousePos, inputPrev.mMousePos, sizeof(inputNew.mMousePos)) != 0 ||
+			memcmp(&inputNew.mMouseWheelVert, &inputPrev.mMouseWheelVert, sizeof(inputNew.mMouseWheelVert)) != 0 ||
+			memcmp(&inputNew.mMouseWheelHoriz, &inputPrev.mMouseWheelHoriz, sizeof(inputNew.mMouseWheelHoriz)) != 0 ||
+			memcmp(&inputNew.mFontDPIScaling, &inputPrev.mFontDPIScaling, sizeof(inputNew.mFontDPIScaling)) != 0 ||
+			memcmp(&inputNew.mDesiredFps, &inputPrev.mDesiredFps, sizeof(inputNew.mDesiredFps)) != 0 ||
+			memcmp(inputNew.mInputDownMask, inputPrev.mInputDownMask, sizeof(inputNew.mInputDownMask)) != 0 ||
+			memcmp(inputNew.mInputAnalog, inputPrev.mInputAnalog, sizeof(inputNew.mInputAnalog)) != 0;
+}
+
 //=================================================================================================
 // INCOM: INPUT
 // Receive new keyboard/mouse/screen resolution input to pass on to dearImgui
@@ -123,6 +141,11 @@ void Communications_Incoming_Input(ClientInfo& client)
 	auto pCmdInput					= static_cast<CmdInput*>(client.mPendingRcv.pCommand);
 	client.mPendingRcv.bAutoFree	= false; // Taking ownership of the data
 	client.mDesiredFps 				= pCmdInput->mDesiredFps > 0.f ? pCmdInput->mDesiredFps : 0.f;
+	client.mFrameIndexAck			= pCmdInput->mFrameIndexAck;
+	if( IsInputChanged(*pCmdInput, client.mInputReceivedPrev) ){
+		client.mbRedrawPending		= true;
+	}
+	client.mInputReceivedPrev		= *pCmdInput;
 	size_t keyCount(pCmdInput->mKeyCharCount);
 	client.mPendingKeyIn.AddData(pCmdInput->mKeyChars, keyCount);
 	client.mPendingInputIn.Assign(pCmdInput);
@@ -140,6 +163,79 @@ void Communications_Incoming_Clipboard(ClientInfo& client)
 	client.mPendingClipboardIn.Assign(pCmdClipboard);
 }
 
+//=================================================================================================
+// INCOM: TEXTURE REQUEST
+// Server doesn't have the content of a texture sent without its pixel data
+//=================================================================================================
+void Communications_Incoming_TextureRequest(ClientInfo& client)
+{
+	auto pCmdRequest				= static_cast<CmdTextureRequest*>(client.mPendingRcv.pCommand);
+	client.mPendingRcv.bAutoFree	= false; // Taking ownership of the data
+	std::lock_guard<std::mutex> guard(client.mPendingTexturesLock);
+	client.mTextureRequests.push_back(pCmdRequest);
+}
+
+//=================================================================================================
+// OUTCOM: TEXTURE VIDEO
+// RGBA8 user textures sent again every frame, are encoded as the difference with their content
+// previously sent (kept here as reference). The Server keeps the same reference to decode them
+// Any other command for a texture invalidates its reference, the Server doing the same
+//=================================================================================================
+static void Communications_Outgoing_TextureVideoClear(ClientInfo& client)
+{
+	for(ClientInfo::VideoReference& videoRef : client.mVideoReferences){
+		netImguiDeleteSafe(videoRef.mpPixels);
+	}
+	client.mVideoReferences.clear();
+}
+
+static CmdTexture* Communications_Outgoing_TextureVideo(ClientInfo& client, CmdTexture& cmdTexture)
+{
+	ClientInfo::VideoReference* pVideoRef = nullptr;
+	for(ClientInfo::VideoReference& videoRef : client.mVideoReferences){
+		pVideoRef = videoRef.mTextureClientID == cmdTexture.mTextureClientID ? &videoRef : pVideoRef;
+	}
+
+	const bool bCreate	= cmdTexture.mStatus == CmdTexture::eType::Create;
+	const bool bStream	= client.mTextureCompression == eTexCompression::kTexCompressionVideo && cmdTexture.mFormat == eTexFormat::kTexFmtRGBA8 &&
+						  cmdTexture.mUpdatable && !cmdTexture.mIsDearImGuiManaged && !cmdTexture.mPayloadBorrowed && !cmdTexture.mPayloadReleased &&
+						  (bCreate || (cmdTexture.mStatus == CmdTexture::eType::Update && pVideoRef));
+	CmdTexture* pCmdVideo = nullptr;
+	if( bStream )
+	{
+		cmdTexture.mpTextureData.ToPointer();
+		pCmdVideo = CompressCmdTextureVideo(&cmdTexture, pVideoRef ? pVideoRef->mpPixels : nullptr, pVideoRef ? pVideoRef->mWidth : 0, pVideoRef ? pVideoRef->mHeight : 0);
+		if( pCmdVideo && bCreate )
+		{
+			if( !pVideoRef ){
+				client.mVideoReferences.push_back(ClientInfo::VideoReference());
+				pVideoRef					= &client.mVideoReferences.back();
+				pVideoRef->mTextureClientID	= cmdTexture.mTextureClientID;
+			}
+			netImguiDeleteSafe(pVideoRef->mpPixels);
+			pVideoRef->mWidth				= cmdTexture.mWidth;
+			pVideoRef->mHeight				= cmdTexture.mHeight;
+			pVideoRef->mpPixels				= netImguiSizedNew<uint8_t>(GetTexture_BytePerImage(eTexFormat::kTexFmtRGBA8, cmdTexture.mWidth, cmdTexture.mHeight));
+			memcpy(pVideoRef->mpPixels, cmdTexture.mpTextureData.Get(), GetTexture_BytePerImage(eTexFormat::kTexFmtRGBA8, cmdTexture.mWidth, cmdTexture.mHeight));
+		}
+		else if( pCmdVideo )
+		{
+			const size_t refPitch	= GetTexture_BytePerLine(eTexFormat::kTexFmtRGBA8, pVideoRef->mWidth);
+			const size_t linePitch	= GetTexture_BytePerLine(eTexFormat::kTexFmtRGBA8, cmdTexture.mWidth);
+			for(uint32_t y(0); y < cmdTexture.mHeight; ++y){
+				memcpy(&pVideoRef->mpPixels[(cmdTexture.mOffsetY + y)*refPitch + cmdTexture.mOffsetX*4], &cmdTexture.mpTextureData.Get()[y*linePitch], linePitch);
+			}
+		}
+		cmdTexture.mpTextureData.ToOffset();
+	}
+
+	if( !pCmdVideo && pVideoRef ){
+		netImguiDeleteSafe(pVideoRef->mpPixels);
+		client.mVideoReferences.erase_unsorted(pVideoRef);
+	}
+	return pCmdVideo;
+}
+
 //=================================================================================================
 // OUTCOM: TEXTURE
 // Transmit the next pending texture command
@@ -159,6 +255,95 @@ void Communications_Outgoing_Textures(ClientInfo& client)
 			client.mPendingSend.bAutoFree	= false; // free handled by main update thread
 		}
 	}
+
+	//---------------------------------------------------------------------
+	// Textures refreshed continuously are sent as their difference with the previous content
+	CmdTexture* pPendingTexture = reinterpret_cast<CmdTexture*>(client.mPendingSend.pCommand);
+	CmdTexture* pTextureVideo	= pPendingTexture ? Communications_Outgoing_TextureVideo(client, *pPendingTexture) : nullptr;
+	if( pTextureVideo )
+	{
+		pTextureVideo->mpTextureData.ToOffset();
+		pPendingTexture->mSent			= true; // Original won't be sent, its content is now owned by the encoded copy
+		client.mPendingSend.pCommand	= pTextureVideo;
+		client.mPendingSend.bAutoFree	= true;
+		return;
+	}
+
+	//---------------------------------------------------------------------
+	// User owned pixels are sent directly from the user buffer, without 
+	// sharing or compression (would need a copy of it)
+	CmdTextureBorrowed* pBorrowed = pPendingTexture ? CmdTextureBorrowed::Get(*pPendingTexture) : nullptr;
+	if( pBorrowed && pPendingTexture->mStatus == CmdTexture::eType::Destroy )
+	{
+		CmdTexture* pTextureHeader		= netImguiNew<CmdTexture>();
+		*pTextureHeader					= *pPendingTexture;
+		pTextureHeader->mSize			= sizeof(CmdTexture);
+		pTextureHeader->mPayloadBorrowed= false;
+		pTextureHeader->mpNext			= nullptr;
+		pTextureHeader->mpTextureData.SetPtr(reinterpret_cast<uint8_t*>(&pTextureHeader[1]));
+		pTextureHeader->mpTextureData.ToOffset();
+		CmdTextureBorrowed::Release(*pPendingTexture);
+		pPendingTexture->mSent			= true; // Destroy only needs the header
+		client.mPendingSend.pCommand	= pTextureHeader;
+		client.mPendingSend.bAutoFree	= true;
+		return;
+	}
+	else if( pBorrowed )
+	{
+		client.mPendingSend.pPayload		= pBorrowed->mpData;
+		client.mPendingSend.PayloadOffset	= sizeof(CmdTexture);
+		return;
+	}
+
+	//---------------------------------------------------------------------
+	// Large textures are first sent without their pixel data. Server uses 
+	// the same content received from another client, or requests it when missing
+	if( pPendingTexture && pPendingTexture->mStatus == CmdTexture::eType::Create && 
+		pPendingTexture->mFormat != eTexFormat::kTexFmtCustom && pPendingTexture->mSize >= sizeof(CmdTexture) + ClientInfo::kTextureShareSizeMin )
+	{
+		if( pPendingTexture->mContentHash == 0 && !IsTextureFormatCompressed(static_cast<eTexFormat>(pPendingTexture->mFormat)) ){
+			pPendingTexture->mpTextureData.ToPointer();
+			pPendingTexture->mContentHash = GetTextureContentHash(pPendingTexture);
+			pPendingTexture->mpTextureData.ToOffset();
+		}
+		if( pPendingTexture->mContentHash != 0 && !pPendingTexture->mPayloadRequired )
+		{
+			CmdTexture* pTextureHeader		= netImguiNew<CmdTexture>();
+			*pTextureHeader					= *pPendingTexture;
+			pTextureHeader->mSize			= sizeof(CmdTexture);
+			pTextureHeader->mFormat			= static_cast<uint8_t>(GetTextureFormatUncompressed(static_cast<eTexFormat>(pPendingTexture->mFormat)));
+			pTextureHeader->mPayloadSkipped	= true;
+			pTextureHeader->mpNext			= nullptr;
+			pTextureHeader->mpTextureData.SetPtr(reinterpret_cast<uint8_t*>(&pTextureHeader[1]));
+			pTextureHeader->mpTextureData.ToOffset();
+			pPendingTexture->mPayloadSkipped= true; // Server might not have this texture, no partial update until sent with its pixel data
+			pPendingTexture->mSent			= true; // Original won't be sent, unless Server requests it
+			client.mPendingSend.pCommand	= pTextureHeader;
+			client.mPendingSend.bAutoFree	= true;
+			return;
+		}
+	}
+
+	if( pPendingTexture ){
+		pPendingTexture->mPayloadSkipped = false; // Sent with its pixel data
+	}
+
+	//---------------------------------------------------------------------
+	// Send a compressed copy of the texture instead, when requested
+	// Original command is kept untouched, since it's tracked for later resend
+	if( pPendingTexture && client.mTextureCompression != eTexCompression::kTexCompressionNone )
+	{
+		pPendingTexture->mpTextureData.ToPointer();
+		CmdTexture* pTextureCompressed = CompressCmdTexture(pPendingTexture, static_cast<eTexCompression>(client.mTextureCompression));
+		pPendingTexture->mpTextureData.ToOffset();
+		if( pTextureCompressed )
+		{
+			pTextureCompressed->mpTextureData.ToOffset();
+			pPendingTexture->mSent			= true; // Original won't be sent, its content is now owned by the compressed copy
+			client.mPendingSend.pCommand	= pTextureCompressed;
+			client.mPendingSend.bAutoFree	= true;
+		}
+	}
 }
 
 //=================================================================================================
@@ -178,30 +363,80 @@ void Communications_Outgoing_Background(ClientInfo& client)
 //=================================================================================================
 // OUTCOM: FRAME
 // Transmit a new dearImgui frame to render
+// DrawFrames are delta compressed against the last one acknowledged by the Server. A frame it
+// couldn't decode doesn't stall the display, the next one still referencing valid data
 //=================================================================================================
+static void Communications_Outgoing_FrameRefsClear(ClientInfo& client)
+{
+	for(CmdDrawFrame* pCmdDraw : client.mCmdDrawRefs){
+		netImguiDelete(pCmdDraw);
+	}
+	client.mCmdDrawRefs.clear();
+}
+
+static CmdDrawFrame* Communications_Outgoing_FrameRef(ClientInfo& client)
+{
+	// Newest frame acknowledged by the Server (or last keyframe, when not acknowledged yet)
+	int refIndex(0);
+	while( refIndex+1 < client.mCmdDrawRefs.size() && client.mCmdDrawRefs[refIndex+1]->mFrameIndex <= client.mFrameIndexAck ){
+		++refIndex;
+	}
+	// Older frames will never be used again, by Client or Server
+	if( refIndex > 0 ){
+		for(int i(0); i < refIndex; ++i){
+			netImguiDelete(client.mCmdDrawRefs[i]);
+		}
+		client.mCmdDrawRefs.erase(client.mCmdDrawRefs.begin(), client.mCmdDrawRefs.begin() + refIndex);
+	}
+	return client.mCmdDrawRefs.empty() ? nullptr : client.mCmdDrawRefs[0];
+}
+
 void Communications_Outgoing_Frame(ClientInfo& client)
 {
 	CmdDrawFrame* pPendingDraw = client.mPendingFrameOut.Release();
 	if( pPendingDraw )
 	{
-		pPendingDraw->mFrameIndex = client.mFrameIndex++;
+		pPendingDraw->mFrameIndex	= client.mFrameIndex++;
+		CmdDrawFrame* pDrawKept		= nullptr;
 		//---------------------------------------------------------------------
 		// Apply delta compression to DrawCommand, when requested
 		if( pPendingDraw->mCompressed )
 		{
+			CmdDrawFrame* pDrawRef	= Communications_Outgoing_FrameRef(client);
+			bool bKeyFrame			= !pDrawRef || client.mServerCompressionSkip || (pPendingDraw->mFrameIndex - client.mFrameIndexKey) >= ClientInfo::kDrawFrameKeyInterval;
+			if( bKeyFrame ){
+				Communications_Outgoing_FrameRefsClear(client);
+				client.mFrameIndexKey		= pPendingDraw->mFrameIndex;
+				client.mFrameIndexExact		= pPendingDraw->mFrameIndex;
+				pPendingDraw->mCompressed	= false;
+			}
+			// Too many frames waiting on acknowledgment, forget the oldest (after current reference)
+			else if( client.mCmdDrawRefs.size() >= ClientInfo::kDrawFrameRefsMax ){
+				netImguiDelete(client.mCmdDrawRefs[1]);
+				client.mCmdDrawRefs.erase(client.mCmdDrawRefs.begin() + 1);
+			}
+
+			// Keep original new command for delta compression of next frames
+			pDrawKept = pPendingDraw;
+			client.mCmdDrawRefs.push_back(pDrawKept);
+
 			// Create a new Compressed DrawFrame Command
-			if( client.mpCmdDrawLast && !client.mServerCompressionSkip ){
-				client.mpCmdDrawLast->ToPointers();
-				CmdDrawFrame* pDrawCompressed	= CompressCmdDrawFrame(client.mpCmdDrawLast, pPendingDraw);
-				netImguiDeleteSafe(client.mpCmdDrawLast);
-				client.mpCmdDrawLast			= pPendingDraw;		// Keep original new command for next frame delta compression
+			if( !bKeyFrame ){
+				pDrawRef->ToPointers();
+				// Small changes from reference are ignored (new frame keeps reference values), except periodically to correct drift
+				if( (pPendingDraw->mFrameIndex - client.mFrameIndexExact) >= ClientInfo::kDrawFrameExactInterval ){
+					client.mFrameIndexExact = pPendingDraw->mFrameIndex;
+				}
+				else if( client.mChangeThresholdPos > 0.f || client.mChangeThresholdColor > 0 ){
+					ApplyChangeThreshold(pDrawRef, pPendingDraw, client.mChangeThresholdPos, client.mChangeThresholdColor);
+				}
+				CmdDrawFrame* pDrawCompressed	= CompressCmdDrawFrame(pDrawRef, pPendingDraw);
+				pDrawCompressed->mFrameIndexRef	= pDrawRef->mFrameIndex;
 				pPendingDraw					= pDrawCompressed;	// Request compressed copy to be sent to server
 			}
-			// Save DrawCmd for next frame delta compression
-			else {
-				pPendingDraw->mCompressed		= false;
-				client.mpCmdDrawLast			= pPendingDraw;
-			}
+		}
+		else {
+			Communications_Outgoing_FrameRefsClear(client);
 		}
 		client.mServerCompressionSkip = false;
 
@@ -209,7 +444,7 @@ void Communications_Outgoing_Frame(ClientInfo& client)
 		// Ready to send command to server
 		pPendingDraw->ToOffsets();
 		client.mPendingSend.pCommand	= pPendingDraw;
-		client.mPendingSend.bAutoFree	= client.mpCmdDrawLast != pPendingDraw;
+		client.mPendingSend.bAutoFree	= pDrawKept != pPendingDraw;
 	}
 }
 
@@ -273,6 +508,7 @@ void Communications_Incoming(ClientInfo& client)
 				{
 					case CmdHeader::eCommands::Input:		Communications_Incoming_Input(client); break;
 					case CmdHeader::eCommands::Clipboard:	Communications_Incoming_Clipboard(client); break;
+					case CmdHeader::eCommands::TextureRequest: Communications_Incoming_TextureRequest(client); break;
 					// Commands not received in main loop, by Client
 					case CmdHeader::eCommands::Version:
 					case CmdHeader::eCommands::Texture:
@@ -315,6 +551,9 @@ void Communications_Outgoing(ClientInfo& client)
 		// Free allocated memory for command
 		if( client.mPendingSend.IsDone() )
 		{
+			if( client.mPendingSend.pPayload ){
+				CmdTextureBorrowed::Release(*static_cast<CmdTexture*>(client.mPendingSend.pCommand));
+			}
 			client.mPendingSend.pCommand->mSent = true;
 			if( client.mPendingSend.IsError() ){
 				client.mbDisconnectPending = true;
@@ -348,6 +587,7 @@ void Communications_Outgoing(ClientInfo& client)
 			// Commands not sent in main loop, by Client
 			case CmdHeader::eCommands::Input:
 			case CmdHeader::eCommands::Version:
+			case CmdHeader::eCommands::TextureRequest:
 			case CmdHeader::eCommands::Count: break;
 		}
 	}
@@ -446,6 +686,10 @@ void Communications_Loop(void* pClientVoid)
 	if (pSocket){
 		NetImgui::Internal::Network::Disconnect(pSocket);
 	}
+	Communications_Outgoing_TextureVideoClear(*pClient); // New connection starts without any reference
+	Communications_Outgoing_FrameRefsClear(*pClient);
+	pClient->mFrameIndexAck			= 0;
+	pClient->mInputReceivedPrev		= CmdInput();
 
 	pClient->mbClientThreadActive 	= false;
 }
@@ -523,9 +767,11 @@ ClientInfo::ClientInfo()
 : mpSocketPending(nullptr)
 , mpSocketComs(nullptr)
 , mpSocketListen(nullptr)
+, mpPendingTexturesAsync(nullptr)
 , mbClientThreadActive(false)
 , mbListenThreadActive(false)
 , mbComInitActive(false)
+, mbRedrawPending(false)
 {
 }
 
@@ -536,15 +782,39 @@ ClientInfo::~ClientInfo()
 {
 	ContextRemoveHooks();
 
-	// Free all tracked textures
-	for(auto cmdTexture : mTrackedTextures){
+	// Free all tracked textures (and let user know its buffers aren't needed anymore)
+	CmdTexture* pCmdAsync = mpPendingTexturesAsync.exchange(nullptr);
+	while( pCmdAsync ){
+		CmdTexture* pCmdNext = pCmdAsync->mpNext;
+		CmdTextureBorrowed::Release(*pCmdAsync);
+		netImguiDelete(pCmdAsync);
+		pCmdAsync = pCmdNext;
+	}
+	for(uint32_t i(0); i<mTrackedTextures.GetSlotCount(); ++i){
+		if( mTrackedTextures.GetSlot(i) ){
+			CmdTextureBorrowed::Release(*mTrackedTextures.GetSlot(i));
+			netImguiDelete(mTrackedTextures.GetSlot(i));
+		}
+	}
+	mTrackedTextures.Clear();
+	for(auto cmdTexture : mTrackedTextureCmds){
+		CmdTextureBorrowed::Release(*cmdTexture);
 		netImguiDelete(cmdTexture);
 	}
-	mTrackedTextures.clear();
+	mTrackedTextureCmds.clear();
+	for(auto pCmdRequest : mTextureRequests){
+		netImguiDelete(pCmdRequest);
+	}
+	mTextureRequests.clear();
 
+	Communications_Outgoing_TextureVideoClear(*this);
 	netImguiDeleteSafe(mpCmdInputPending);
-	netImguiDeleteSafe(mpCmdDrawLast);
+	Communications_Outgoing_FrameRefsClear(*this);
 	netImguiDeleteSafe(mpCmdClipboard);
+	for(auto& windowThrottle : mWindowThrottles){
+		WindowThrottleClear(windowThrottle);
+	}
+	mWindowThrottles.clear();
 }
 
 //=================================================================================================
@@ -609,10 +879,15 @@ void ClientInfo::ContextOverride()
 		newIO.ConfigFlags &= ~(ImGuiConfigFlags_ViewportsEnable); // Viewport unsupported at the moment
 #endif
 
-		// Resend every tracked textures
-		for(auto textureCmd : mTrackedTextures ){
-			if( textureCmd->mStatus == CmdTexture::eType::Create ){
-				TexturePendingServerAdd(*textureCmd);
+		// Resend every tracked textures (or ask user for the ones without their pixel data kept)
+		TextureTrackingRetain(); // User owned pixels already sent are not available anymore
+		for(uint32_t i(0); i<mTrackedTextures.GetSlotCount(); ++i){
+			CmdTexture* pCmdTexture = mTrackedTextures.GetSlot(i);
+			if( pCmdTexture && pCmdTexture->mPayloadReleased ){
+				mTexturesRefetch.push_back(pCmdTexture->mTextureClientID);
+			}
+			else if( pCmdTexture ){
+				TexturePendingServerAdd(*pCmdTexture);
 			}
 		}
 
@@ -724,12 +999,15 @@ void ClientInfo::TextureTrackingClear()
 	// they will be resent on reconnect
 	if( !IsConnected() && mDearImguiTextureCount > 0 )
 	{
-		for(auto pCmdTexture : mTrackedTextures )
+		for(uint32_t i(0); i<mTrackedTextures.GetSlotCount(); )
 		{
-			if( pCmdTexture->mIsDearImGuiManaged )
+			CmdTexture* pCmdTexture = mTrackedTextures.GetSlot(i);
+			if( pCmdTexture && pCmdTexture->mIsDearImGuiManaged )
 			{
 				mbTrackedTexturesPending |= TextureTrackingRem(pCmdTexture->mTextureClientID);
+				continue; // Re-process same slot, it now contains another entry
 			}
+			++i;
 		}
 	}
 #endif
@@ -759,13 +1037,17 @@ void ClientInfo::TextureTrackingUpdate(bool bResendAll)
 			uint32_t dataSize			= 0;
 			uint16_t w					= static_cast<uint16_t>(TexData->Width);
 			uint16_t h					= static_cast<uint16_t>(TexData->Height);
+			const bool bResendTexture	=	!mTexturesResendManaged.empty() && TexStatus != ImTextureStatus_Destroyed && TexStatus != ImTextureStatus_WantDestroy &&
+											mTexturesResendManaged.contains(ConvertToClientTexID(ClientTextureRef));
 
-			if( (TexStatus == ImTextureStatus_WantCreate) ||
+			if( (TexStatus == ImTextureStatus_WantCreate) || bResendTexture ||
 				(bResendAll && TexStatus != ImTextureStatus_Destroyed && TexStatus != ImTextureStatus_WantDestroy))
 			{
 				// @sammyfreg todo 	UserID and mClientTextureIDNext used for dear imgui managed's textures
 				//					could potentially collide when generating ClientTextureID. Needs something more robust.
-				TexData->UniqueID 		= ++mClientTextureIDNext;
+				if( !bResendTexture ){
+					TexData->UniqueID	= ++mClientTextureIDNext;	// Texture requested by Server keeps its ID
+				}
 				CmdTexture* pCmdTexture	= TextureCmdAllocate(ConvertToClientTexID(ClientTextureRef), w, h, TexFormat, dataSize);
 				if( pCmdTexture )
 				{
@@ -801,8 +1083,7 @@ void ClientInfo::TextureTrackingUpdate(bool bResendAll)
 					pCmdTexture->mUpdatable	= true;
 					pCmdTexture->mIsDearImGuiManaged = true;
 					pCmdTexture->mpTextureData.ToOffset();
-					TexturePendingServerAdd(*pCmdTexture);		// Request texture to be sent over to Server
-					mbTrackedTexturesPending = true;
+					TextureTrackingAddUpdate(*pCmdTexture);		// Request texture to be sent over to Server
 				}
 			}
 		}
@@ -810,15 +1091,13 @@ void ClientInfo::TextureTrackingUpdate(bool bResendAll)
 		//------------------------------------------------------------------------
 		// Detects Textures changes that have not been tracked
 		// (caused by internal font atlas changes)
-		// This is not ideal with large texture count but should be ok for most
-		// cases. Using a unordered_map for 'mTrackedTextures' could help for 
-		// high count, but adds a std dependency
 		//------------------------------------------------------------------------
 		if( mDearImguiTextureCount != Textures.Size )
 		{
-			for(auto pCmdTexture : mTrackedTextures )
+			for(uint32_t slot(0); slot<mTrackedTextures.GetSlotCount(); )
 			{
-				if( pCmdTexture->mIsDearImGuiManaged )
+				CmdTexture* pCmdTexture = mTrackedTextures.GetSlot(slot);
+				if( pCmdTexture && pCmdTexture->mIsDearImGuiManaged )
 				{
 					bool bFound(false);
 					for(int i(0); !bFound && i<Textures.Size; ++i)
@@ -829,31 +1108,99 @@ void ClientInfo::TextureTrackingUpdate(bool bResendAll)
 					if( !bFound )
 					{
 						mbTrackedTexturesPending |= TextureTrackingRem(pCmdTexture->mTextureClientID);
+						continue; // Re-process same slot, it now contains another entry
 					}
 				}
+				++slot;
 			}
 		}
 	}	
 #endif
+	mTexturesResendManaged.clear();
+
+	//----------------------------------------
+	// Track textures added from other threads, with user owned pixels
+	CmdTexture* pCmdAsync = mpPendingTexturesAsync.exchange(nullptr);
+	CmdTexture* pCmdAsyncOrdered = nullptr;
+	while( pCmdAsync ){ // Reverse list order, to process oldest entry first
+		CmdTexture* pCmdNext		= pCmdAsync->mpNext;
+		pCmdAsync->mpNext			= pCmdAsyncOrdered;
+		pCmdAsyncOrdered			= pCmdAsync;
+		pCmdAsync					= pCmdNext;
+	}
+	while( pCmdAsyncOrdered ){
+		CmdTexture* pCmdNext		= pCmdAsyncOrdered->mpNext;
+		pCmdAsyncOrdered->mpNext	= nullptr;
+		pCmdAsyncOrdered->mUpdatable= pCmdAsyncOrdered->mFormat != eTexFormat::kTexFmtCustom && TextureTrackingFind(pCmdAsyncOrdered->mTextureClientID) != nullptr;
+		TextureTrackingAdd(*pCmdAsyncOrdered);
+		pCmdAsyncOrdered			= pCmdNext;
+	}
+
+	//----------------------------------------
+	// Resend textures with their pixel data, when Server didn't already have them
+	if( !mTextureRequests.empty() )
+	{
+		ImVector<CmdTextureRequest*> textureRequests;
+		{
+			std::lock_guard<std::mutex> guard(mPendingTexturesLock);
+			textureRequests.swap(mTextureRequests);
+		}
+		for(CmdTextureRequest* pCmdRequest : textureRequests)
+		{
+			// Note: Content hash can differ from the request when texture was modified since, the current content is sent
+			CmdTexture* pCmdTexture = TextureTrackingFind(pCmdRequest->mTextureClientID);
+			if( pCmdTexture && pCmdTexture->mSent ){
+				if( pCmdTexture->mIsDearImGuiManaged ){
+					mTexturesResendManaged.push_back(pCmdTexture->mTextureClientID); // Tracked copy doesn't include its updates, resend from Dear ImGui texture
+				}
+				else if( pCmdTexture->mPayloadReleased ){
+					mTexturesRefetch.push_back(pCmdTexture->mTextureClientID);
+				}
+				else {
+					pCmdTexture->mPayloadRequired = true;
+					TexturePendingServerAdd(*pCmdTexture);
+				}
+			}
+			netImguiDelete(pCmdRequest);
+		}
+	}
+
+	//----------------------------------------
+	// Ask user to send again the textures we don't have the pixel data of anymore
+	if( !mTexturesRefetch.empty() )
+	{
+		ImVector<ClientTextureID> texturesRefetch;
+		texturesRefetch.swap(mTexturesRefetch);
+		for(ClientTextureID clientTexID : texturesRefetch)
+		{
+			CmdTexture* pCmdTexture = TextureTrackingFind(clientTexID);
+			if( mTextureRefetchFunction && pCmdTexture && pCmdTexture->mPayloadReleased ){
+				mTextureRefetchFunction(ConvertFromClientTexID(clientTexID));
+			}
+		}
+	}
+
+	//----------------------------------------
+	TextureTrackingRetain();
 
 	//----------------------------------------
 	if( mbTrackedTexturesPending )
 	{
-		int TrackedCount(mTrackedTextures.Size);
+		int TrackedCount(mTrackedTextureCmds.Size);
 		mbTrackedTexturesPending = false;
 		for(int i(0); i<TrackedCount; ++i)
 		{
-			mbTrackedTexturesPending |= !mTrackedTextures[i]->mSent && mTrackedTextures[i]->mStatus != CmdTexture::eType::Create;
+			mbTrackedTexturesPending |= !mTrackedTextureCmds[i]->mSent;
 			// As soon as we detect a command to be un-needed, release it
-			if( mTrackedTextures[i]->mSent && 
-				mTrackedTextures[i]->mStatus != CmdTexture::eType::Create )
+			if( mTrackedTextureCmds[i]->mSent )
 			{
-				netImguiDelete(mTrackedTextures[i]);
-				mTrackedTextures[i] = mTrackedTextures[--TrackedCount]; // Erase swap with last element
+				CmdTextureBorrowed::Release(*mTrackedTextureCmds[i]);
+				netImguiDelete(mTrackedTextureCmds[i]);
+				mTrackedTextureCmds[i] = mTrackedTextureCmds[--TrackedCount]; // Erase swap with last element
 				--i; // re-process same index after its entry was swapped with last valid element
 			}
 		}
-		mTrackedTextures.resize(TrackedCount);
+		mTrackedTextureCmds.resize(TrackedCount);
 	}
 }
 
@@ -887,8 +1234,13 @@ bool ClientInfo::TextureTrackingAdd(CmdTexture& cmdTexture)
 	}
 
 	TextureTrackingRem(cmdTexture.mTextureClientID);
-	mTrackedTextures.push_back(&cmdTexture);	// Add the new entry needing to be tracked
-	TexturePendingServerAdd(cmdTexture);		// Request texture to be sent over to Server
+	mTrackedTextures.Insert(cmdTexture);		// Add the new entry needing to be tracked
+	if( !TexturePendingServerAdd(cmdTexture) ){	// Request texture to be sent over to Server
+		cmdTexture.mSent = true;				// Not connected, will be sent on next connection
+	}
+	if( (mTextureRetention != eTexRetention::kTexRetentionCopy || cmdTexture.mPayloadBorrowed) && !cmdTexture.mIsDearImGuiManaged ){
+		mTrackedTexturesRetain.push_back(cmdTexture.mTextureClientID);
+	}
 	mDearImguiTextureCount += cmdTexture.mIsDearImGuiManaged ? 1 : 0;
 	return true;
 }
@@ -897,26 +1249,356 @@ bool ClientInfo::TextureTrackingRem(ClientTextureID clientTextureID)
 {
 	// If texture has been sent to server, re-purpose existing command 
 	// as a 'destroy' and re-send it to server
-	for(int i(0); i<mTrackedTextures.Size; ++i)
+	CmdTexture* pCmdTexture = mTrackedTextures.Remove(clientTextureID);
+	if( pCmdTexture )
+	{
+		pCmdTexture->mSent		= false;
+		pCmdTexture->mStatus 	= CmdTexture::eType::Destroy;	// Re-purpose create cmd to destroy the texture
+		if( !TexturePendingServerAdd(*pCmdTexture) ){
+			pCmdTexture->mSent	= true;							// Nothing to send when not connected, can be released right away
+		}
+
+		// Release the command once sent
+		mDearImguiTextureCount -= pCmdTexture->mIsDearImGuiManaged ? 1 : 0;
+		mTrackedTextureCmds.push_back(pCmdTexture);
+		mbTrackedTexturesPending = true;
+		return true;
+	}
+	return false;
+}
+
+// Find the create command of a tracked client texture
+CmdTexture* ClientInfo::TextureTrackingFind(ClientTextureID clientTextureID)
+{
+	return mTrackedTextures.Find(clientTextureID);
+}
+
+// Send a partial texture update to server (released after being sent)
+void ClientInfo::TextureTrackingAddUpdate(CmdTexture& cmdTexture)
+{
+	mTrackedTextureCmds.push_back(&cmdTexture);
+	if( !TexturePendingServerAdd(cmdTexture) ){
+		cmdTexture.mSent = true;	// Nothing to send when not connected, can be released right away
+	}
+	mbTrackedTexturesPending = true;
+}
+
+//=================================================================================================
+// Once sent to the Server, replace tracked textures commands with a smaller version of it, 
+// following the user selected texture retention mode
+//=================================================================================================
+void ClientInfo::TextureTrackingRetain()
+{
+	int RetainCount(mTrackedTexturesRetain.Size);
+	for(int i(0); i<RetainCount; ++i)
 	{
-		CmdTexture* pCmdTexture = mTrackedTextures[i];
-		if( pCmdTexture && pCmdTexture->mTextureClientID == clientTextureID && pCmdTexture->mStatus == CmdTexture::eType::Create )
+		CmdTexture* pCmdTexture = mTrackedTextures.Find(mTrackedTexturesRetain[i]);
+		if( pCmdTexture && !pCmdTexture->mSent ){
+			continue; // Still waiting to be sent
+		}
+
+		CmdTexture* pCmdRetained = nullptr;
+		if( pCmdTexture && !pCmdTexture->mPayloadReleased && (pCmdTexture->mPayloadBorrowed || !IsTextureFormatCompressed(static_cast<eTexFormat>(pCmdTexture->mFormat))) )
 		{
-			pCmdTexture->mSent		= false;
-			pCmdTexture->mStatus 	= CmdTexture::eType::Destroy;	// Re-purpose create cmd to destroy the texture
-			TexturePendingServerAdd(*pCmdTexture);
+			if( mTextureRetention == eTexRetention::kTexRetentionCompressed && !pCmdTexture->mPayloadBorrowed )
+			{
+				pCmdTexture->mpTextureData.ToPointer();
+				CmdTexture* pCmdPacked = CompressCmdTexture(pCmdTexture, eTexCompression::kTexCompressionLossless);
+				pCmdTexture->mpTextureData.ToOffset();
+				if( pCmdPacked )
+				{
+					// Compressed command is allocated with the worst case size, keep an exact sized copy
+					pCmdRetained	= netImguiSizedNew<CmdTexture>(pCmdPacked->mSize);
+					*pCmdRetained	= *pCmdPacked;
+					pCmdRetained->mpTextureData.SetPtr(reinterpret_cast<uint8_t*>(&pCmdRetained[1]));
+					memcpy(pCmdRetained->mpTextureData.Get(), pCmdPacked->mpTextureData.Get(), pCmdPacked->mSize - sizeof(CmdTexture));
+					pCmdRetained->mpTextureData.ToOffset();
+					netImguiDelete(pCmdPacked);
+				}
+			}
+			else if( mTextureRetention == eTexRetention::kTexRetentionNone || pCmdTexture->mPayloadBorrowed )
+			{
+				pCmdRetained					= netImguiNew<CmdTexture>();
+				*pCmdRetained					= *pCmdTexture;
+				pCmdRetained->mSize				= sizeof(CmdTexture);
+				pCmdRetained->mPayloadReleased	= true;
+				pCmdRetained->mPayloadBorrowed	= false;
+				pCmdRetained->mpTextureData.SetPtr(reinterpret_cast<uint8_t*>(&pCmdRetained[1]));
+				pCmdRetained->mpTextureData.ToOffset();
+			}
+		}
 
-			// Remove item from our list
-			mDearImguiTextureCount -= pCmdTexture->mIsDearImGuiManaged ? 1 : 0;
-			mTrackedTextures[i] = mTrackedTextures.back();
-			mTrackedTextures.pop_back();
-			return true;
+		if( pCmdRetained ){
+			mTrackedTextures.Insert(*pCmdRetained);
+			CmdTextureBorrowed::Release(*pCmdTexture);
+			netImguiDelete(pCmdTexture);
 		}
+		mTrackedTexturesRetain[i] = mTrackedTexturesRetain[--RetainCount]; // Erase swap with last element
+		--i; // re-process same index after its entry was swapped with last valid element
 	}
-	return false;
+	mTrackedTexturesRetain.resize(RetainCount);
+}
+
+static inline size_t GetAllocatedSize(const CmdTexture& cmdTexture)
+{
+	return cmdTexture.mPayloadBorrowed ? sizeof(CmdTexture) + sizeof(CmdTextureBorrowed) : cmdTexture.mSize;
+}
+
+//=================================================================================================
+// Memory used by the tracked texture commands (pixel data kept to resend them, and pending ones)
+//=================================================================================================
+uint64_t ClientInfo::TextureTrackingMemoryUsage()const
+{
+	uint64_t memoryUsage = static_cast<uint64_t>(mTrackedTextures.GetSlotCount()) * sizeof(CmdTexture*);
+	for(uint32_t i(0); i<mTrackedTextures.GetSlotCount(); ++i){
+		memoryUsage += mTrackedTextures.GetSlot(i) ? GetAllocatedSize(*mTrackedTextures.GetSlot(i)) : 0;
+	}
+	for(const CmdTexture* pCmdTexture : mTrackedTextureCmds){
+		memoryUsage += GetAllocatedSize(*pCmdTexture);
+	}
+	return memoryUsage;
+}
+
+//=================================================================================================
+// Queue a texture command with user owned pixels, from any thread
+//=================================================================================================
+void ClientInfo::TextureTrackingAddAsync(CmdTexture& cmdTexture)
+{
+	cmdTexture.mpNext = mpPendingTexturesAsync.load();
+	while( !mpPendingTexturesAsync.compare_exchange_weak(cmdTexture.mpNext, &cmdTexture) ){}
+}
+
+//=================================================================================================
+// TEXTURE BORROWED
+//=================================================================================================
+CmdTexture* CmdTextureBorrowed::Allocate(ClientTextureID clientTexID, const void* pData, uint16_t width, uint16_t height, eTexFormat format, uint32_t dataSize, TextureSentFuncPtr sentFunction, void* pUserData)
+{
+	if( format != eTexFormat::kTexFmtCustom ){
+		dataSize = GetTexture_BytePerImage(format, width, height);
+	}
+
+	CmdTexture* pCmdTexture = netImguiSizedNew<CmdTexture>(sizeof(CmdTexture) + sizeof(CmdTextureBorrowed));
+	if( pCmdTexture )
+	{
+		pCmdTexture->mpTextureData.SetPtr(reinterpret_cast<uint8_t*>(&pCmdTexture[1]));
+		pCmdTexture->mpTextureData.ToOffset();
+		pCmdTexture->mStatus			= CmdTexture::eType::Create;
+		pCmdTexture->mSize				= static_cast<uint32_t>(sizeof(CmdTexture) + dataSize); // Size sent to Server, not the allocated size
+		pCmdTexture->mWidth				= width;
+		pCmdTexture->mHeight			= height;
+		pCmdTexture->mTextureClientID	= clientTexID;
+		pCmdTexture->mFormat			= static_cast<uint8_t>(format);
+		pCmdTexture->mPayloadBorrowed	= true;
+		CmdTextureBorrowed* pBorrowed	= new( &pCmdTexture[1] ) CmdTextureBorrowed();
+		pBorrowed->mpData				= reinterpret_cast<const uint8_t*>(pData);
+		pBorrowed->mSentFunction		= sentFunction;
+		pBorrowed->mpUserData			= pUserData;
+	}
+	return pCmdTexture;
+}
+
+void CmdTextureBorrowed::Release(CmdTexture& cmdTexture)
+{
+	CmdTextureBorrowed* pBorrowed = Get(cmdTexture);
+	TextureSentFuncPtr sentFunction = pBorrowed ? pBorrowed->mSentFunction.exchange(nullptr) : nullptr;
+	if( sentFunction ){
+		sentFunction(ConvertFromClientTexID(cmdTexture.mTextureClientID), pBorrowed->mpUserData);
+	}
+}
+
+//=================================================================================================
+// TEXTURE TABLE
+//=================================================================================================
+uint32_t TextureTable::GetSlotIndex(ClientTextureID clientTextureID)const
+{
+	// Mix the bits of the ID (often a pointer value, with low bits unused)
+	uint64_t hash	= clientTextureID;
+	hash			^= hash >> 33;
+	hash			*= 0xFF51AFD7ED558CCDull;
+	hash			^= hash >> 33;
+	return static_cast<uint32_t>(hash) & static_cast<uint32_t>(mSlots.Size - 1);
 }
 
-void ClientInfo::TexturePendingServerAdd(CmdTexture& cmdTexture)
+CmdTexture* TextureTable::Find(ClientTextureID clientTextureID)const
+{
+	if( mCount == 0 ){
+		return nullptr;
+	}
+
+	uint32_t slotMask	= static_cast<uint32_t>(mSlots.Size - 1);
+	uint32_t slotIndex	= GetSlotIndex(clientTextureID);
+	while( mSlots[static_cast<int>(slotIndex)] != nullptr )
+	{
+		if( mSlots[static_cast<int>(slotIndex)]->mTextureClientID == clientTextureID ){
+			return mSlots[static_cast<int>(slotIndex)];
+		}
+		slotIndex = (slotIndex + 1) & slotMask;
+	}
+	return nullptr;
+}
+
+CmdTexture* TextureTable::Insert(CmdTexture& cmdTexture)
+{
+	// Keep load factor under 50%, to limit probing distance
+	if( (mCount + 1) * 2 > static_cast<uint32_t>(mSlots.Size) ){
+		Grow();
+	}
+
+	uint32_t slotMask	= static_cast<uint32_t>(mSlots.Size - 1);
+	uint32_t slotIndex	= GetSlotIndex(cmdTexture.mTextureClientID);
+	while( mSlots[static_cast<int>(slotIndex)] != nullptr )
+	{
+		CmdTexture* pCmdTexture = mSlots[static_cast<int>(slotIndex)];
+		if( pCmdTexture->mTextureClientID == cmdTexture.mTextureClientID ){
+			mSlots[static_cast<int>(slotIndex)] = &cmdTexture;
+			return pCmdTexture;
+		}
+		slotIndex = (slotIndex + 1) & slotMask;
+	}
+	mSlots[static_cast<int>(slotIndex)] = &cmdTexture;
+	mCount++;
+	return nullptr;
+}
+
+CmdTexture* TextureTable::Remove(ClientTextureID clientTextureID)
+{
+	if( mCount == 0 ){
+		return nullptr;
+	}
+
+	uint32_t slotMask	= static_cast<uint32_t>(mSlots.Size - 1);
+	uint32_t slotIndex	= GetSlotIndex(clientTextureID);
+	while( mSlots[static_cast<int>(slotIndex)] != nullptr && mSlots[static_cast<int>(slotIndex)]->mTextureClientID != clientTextureID ){
+		slotIndex = (slotIndex + 1) & slotMask;
+	}
+
+	CmdTexture* pCmdRemoved = mSlots[static_cast<int>(slotIndex)];
+	if( pCmdRemoved )
+	{
+		// Move back the following entries of the probing chain into the freed slot,
+		// when it is not before their ideal position (keeps lookup valid without tombstone)
+		uint32_t slotFree	= slotIndex;
+		uint32_t slotNext	= (slotIndex + 1) & slotMask;
+		while( mSlots[static_cast<int>(slotNext)] != nullptr )
+		{
+			uint32_t slotIdeal = GetSlotIndex(mSlots[static_cast<int>(slotNext)]->mTextureClientID);
+			if( ((slotNext - slotIdeal) & slotMask) >= ((slotNext - slotFree) & slotMask) )
+			{
+				mSlots[static_cast<int>(slotFree)]	= mSlots[static_cast<int>(slotNext)];
+				slotFree							= slotNext;
+			}
+			slotNext = (slotNext + 1) & slotMask;
+		}
+		mSlots[static_cast<int>(slotFree)] = nullptr;
+		mCount--;
+	}
+	return pCmdRemoved;
+}
+
+void TextureTable::Clear()
+{
+	mSlots.clear();
+	mCount = 0;
+}
+
+void TextureTable::Grow()
+{
+	ImVector<CmdTexture*> slotsPrev;
+	slotsPrev.swap(mSlots);
+	mSlots.resize(slotsPrev.Size > 0 ? slotsPrev.Size * 2 : static_cast<int>(kSlotCountMin), nullptr);
+	mCount = 0;
+	for(CmdTexture* pCmdTexture : slotsPrev){
+		if( pCmdTexture ){
+			Insert(*pCmdTexture);
+		}
+	}
+}
+
+//=================================================================================================
+// Refresh the content of a texture already received by the Server, by comparing it with the 
+// last sent pixels in tiles, and only sending the modified areas as partial updates.
+// Returns false when a new texture must be created instead (not sent yet or without its pixel data, size/format change, ...)
+//=================================================================================================
+bool ClientInfo::TextureTrackingUpdateData(ClientTextureID clientTextureID, const void* pData, uint16_t width, uint16_t height, eTexFormat format)
+{
+	constexpr uint32_t kTileSize		= 64;	// Size of the area compared between the previous and new content
+	constexpr int kUpdateCountMax		= 32;	// Past this number of modified areas, send the entire texture content in 1 update
+
+	CmdTexture* pCmdCreate = TextureTrackingFind(clientTextureID);
+	if( !pCmdCreate || !pCmdCreate->mSent || !pCmdCreate->mUpdatable || pCmdCreate->mIsDearImGuiManaged || pCmdCreate->mPayloadReleased || pCmdCreate->mPayloadBorrowed || pCmdCreate->mPayloadSkipped ||
+		pCmdCreate->mWidth != width || pCmdCreate->mHeight != height || pCmdCreate->mFormat != format || 
+		format == eTexFormat::kTexFmtCustom || !IsConnected() )
+	{
+		return false;
+	}
+
+	// Find the modified tiles, merging adjacent ones on a same row
+	struct UpdateArea { uint32_t x, y, w, h; };
+	ImVector<UpdateArea> updateAreas;
+	const uint32_t bytePerPixel		= GetTexture_BitsPerPixel(format) / 8;
+	const size_t pitch				= GetTexture_BytePerLine(format, width);
+	const uint8_t* pDataNew			= reinterpret_cast<const uint8_t*>(pData);
+	uint8_t* pDataSent				= pCmdCreate->mpTextureData.ToPointer();
+	const uint32_t tileCountX		= DivUp<uint32_t>(width, kTileSize);
+	for(uint32_t tileY(0); tileY < height; tileY += kTileSize)
+	{
+		const uint32_t tileH	= (height - tileY) < kTileSize ? (height - tileY) : kTileSize;
+		uint32_t dirtyStartX	= tileCountX;
+		for(uint32_t tileIdx(0); tileIdx <= tileCountX; ++tileIdx)
+		{
+			bool bModified = false;
+			if( tileIdx < tileCountX )
+			{
+				const uint32_t tileX	= tileIdx * kTileSize;
+				const size_t lineBytes	= static_cast<size_t>((width - tileX) < kTileSize ? (width - tileX) : kTileSize) * bytePerPixel;
+				const size_t offset		= static_cast<size_t>(tileY) * pitch + static_cast<size_t>(tileX) * bytePerPixel;
+				for(uint32_t y(0); y < tileH && !bModified; ++y){
+					bModified = memcmp(&pDataSent[offset + y*pitch], &pDataNew[offset + y*pitch], lineBytes) != 0;
+				}
+			}
+			if( bModified && dirtyStartX == tileCountX ){
+				dirtyStartX = tileIdx;
+			}
+			else if( !bModified && dirtyStartX != tileCountX ){
+				const uint32_t x = dirtyStartX * kTileSize;
+				const uint32_t w = (tileIdx * kTileSize < width ? tileIdx * kTileSize : width) - x;
+				updateAreas.push_back({x, tileY, w, tileH});
+				dirtyStartX = tileCountX;
+			}
+		}
+	}
+	if( updateAreas.Size > kUpdateCountMax ){
+		updateAreas.resize(1);
+		updateAreas[0] = {0, 0, width, height};
+	}
+
+	// Send the modified areas and keep a copy of the new content for the next comparison
+	for(const UpdateArea& area : updateAreas)
+	{
+		uint32_t dataSize		= 0;
+		CmdTexture* pCmdUpdate	= TextureCmdAllocate(clientTextureID, static_cast<uint16_t>(area.w), static_cast<uint16_t>(area.h), format, dataSize);
+		if( pCmdUpdate )
+		{
+			const size_t lineBytes	= static_cast<size_t>(area.w) * bytePerPixel;
+			uint8_t* pDataDst		= pCmdUpdate->mpTextureData.Get();
+			for(uint32_t y(0); y < area.h; ++y){
+				memcpy(&pDataDst[y*lineBytes], &pDataNew[(area.y + y)*pitch + static_cast<size_t>(area.x)*bytePerPixel], lineBytes);
+			}
+			pCmdUpdate->mStatus		= CmdTexture::eType::Update;
+			pCmdUpdate->mOffsetX	= static_cast<uint16_t>(area.x);
+			pCmdUpdate->mOffsetY	= static_cast<uint16_t>(area.y);
+			pCmdUpdate->mUpdatable	= true;
+			pCmdUpdate->mpTextureData.ToOffset();
+			TextureTrackingAddUpdate(*pCmdUpdate);
+		}
+	}
+	memcpy(pDataSent, pDataNew, pitch * height);
+	pCmdCreate->mpTextureData.ToOffset();
+	pCmdCreate->mContentHash = 0; // Content changed, hash must be recomputed on next send
+	return true;
+}
+
+bool ClientInfo::TexturePendingServerAdd(CmdTexture& cmdTexture)
 {
 	std::lock_guard<std::mutex> guard(mPendingTexturesLock);
 	if( IsConnected() )
@@ -928,23 +1610,34 @@ void ClientInfo::TexturePendingServerAdd(CmdTexture& cmdTexture)
 		{
 			// Remove all unprocessed texture commands with same id
 			// (only need the latest action for create/destroy, but can have multiple update queued)
-			if(	cmdTexture.mStatus != CmdTexture::eType::Update &&
-				cmdTexture.mSent == false &&
-				cmdTexture.mTextureClientID == pendingTexture->mTextureClientID )
+			if( pendingTexture == &cmdTexture )
+			{
+				// Same command queued again (create re-purposed as destroy), move it to the end
+				*ppNextTexture			= pendingTexture->mpNext;
+			}
+			else if(cmdTexture.mStatus != CmdTexture::eType::Update &&
+					cmdTexture.mSent == false &&
+					cmdTexture.mTextureClientID == pendingTexture->mTextureClientID )
 			{
 				// Mark as sent and un-needed (which gets it removed from tracking array and deleted later)
 				pendingTexture->mSent	= true;
 				pendingTexture->mStatus	= CmdTexture::eType::Destroy;
 				*ppNextTexture			= pendingTexture->mpNext;
 			}
-			ppNextTexture	= &pendingTexture->mpNext;
-			pendingTexture 	= pendingTexture->mpNext;
+			else
+			{
+				ppNextTexture			= &pendingTexture->mpNext;
+			}
+			pendingTexture 	= *ppNextTexture;
 		}
 
 		// Add as last element and ready to be sent
 		cmdTexture.mSent	= false;
+		cmdTexture.mpNext	= nullptr;
 		*ppNextTexture		= &cmdTexture;
+		return true;
 	}
+	return false;
 }
 
 //=================================================================================================
@@ -957,11 +1650,104 @@ void ClientInfo::ProcessDrawData(const ImDrawData* pDearImguiData, ImGuiMouseCur
 	if( !mbValidDrawFrame )
 		return;
 
-	CmdDrawFrame* pDrawFrameNew = ConvertToCmdDrawFrame(pDearImguiData, mouseCursor);
+	const ImDrawList* const* ppDrawListsOverride = mWindowThrottles.empty() ? nullptr : WindowThrottleUpdate(pDearImguiData);
+	CmdDrawFrame* pDrawFrameNew = ConvertToCmdDrawFrame(pDearImguiData, mouseCursor, static_cast<eVertexPrecision>(mVertexPrecision), ppDrawListsOverride);
 	pDrawFrameNew->mCompressed	= mClientCompressionMode == eCompressionMode::kForceEnable || (mClientCompressionMode == eCompressionMode::kUseServerSetting && mServerCompressionEnabled);
 	mPendingFrameOut.Assign(pDrawFrameNew);
 }
 
+//=================================================================================================
+// Windows with a limited update rate (see 'SetWindowUpdateInterval') keep sending a copy of the
+// draw lists of their last update, until their interval elapsed. With delta compression, 
+// unchanged content costs almost nothing to send.
+// Windows being hovered or focused are always updated, to keep interactions responsive.
+//=================================================================================================
+const ImDrawList* const* ClientInfo::WindowThrottleUpdate(const ImDrawData* pDearImguiData)
+{
+	const ImGuiContext& g		= *ImGui::GetCurrentContext();
+	const ImGuiWindow* pHovered	= g.HoveredWindow ? g.HoveredWindow->RootWindow : nullptr;
+	const ImGuiWindow* pFocused	= g.NavWindow ? g.NavWindow->RootWindow : nullptr;
+	const TimePoint timeNow		= std::chrono::steady_clock::now();
+	bool bTexturesChanged		= false;
+#if NETIMGUI_IMGUI_TEXTURES_ENABLED
+	// Snapshots reference Dear ImGui textures objects, can't keep them once a texture is released
+	const ImVector<ImTextureData*>& textures = ImGui::GetPlatformIO().Textures;
+	bTexturesChanged			= mWindowThrottleTextures.Size != textures.Size || (textures.Size > 0 && memcmp(mWindowThrottleTextures.Data, textures.Data, static_cast<size_t>(textures.size_in_bytes())) != 0);
+	if( bTexturesChanged ){
+		mWindowThrottleTextures = textures;
+	}
+#endif
+	for(auto& windowThrottle : mWindowThrottles){
+		windowThrottle.mDrawListCount	= 0;
+		windowThrottle.mbInteracting	= false;
+	}
+
+	//---------------------------------------------------------------------------------------------
+	// Find the throttled window owning each draw list (child windows follow their root window)
+	//---------------------------------------------------------------------------------------------
+	mWindowThrottleIndices.resize(pDearImguiData->CmdListsCount);
+	for(int n = 0; n < pDearImguiData->CmdListsCount; n++)
+	{
+		const ImDrawList* pCmdList	= pDearImguiData->CmdLists[n];
+		const ImGuiWindow* pWindow	= pCmdList->_OwnerName ? ImGui::FindWindowByName(pCmdList->_OwnerName) : nullptr;
+		const ImGuiWindow* pRoot	= pWindow ? pWindow->RootWindow : nullptr;
+		int throttleIndex			= -1;
+		for(int i = 0; pRoot && i < mWindowThrottles.Size && throttleIndex < 0; ++i){
+			throttleIndex = mWindowThrottles[i].mWindowID == pRoot->ID ? i : -1;
+		}
+		if( throttleIndex >= 0 ){
+			WindowThrottle& windowThrottle	= mWindowThrottles[throttleIndex];
+			windowThrottle.mDrawListCount	+= 1;
+			windowThrottle.mbInteracting	|= pRoot == pHovered || pRoot == pFocused;
+		}
+		mWindowThrottleIndices[n] = throttleIndex;
+	}
+
+	//---------------------------------------------------------------------------------------------
+	// Decide which window gets updated. Snapshots can't be used when the window draw lists 
+	// changed (window hidden, child window added, ...)
+	//---------------------------------------------------------------------------------------------
+	for(auto& windowThrottle : mWindowThrottles){
+		const float elapsed				= std::chrono::duration<float>(timeNow - windowThrottle.mUpdateTime).count();
+		windowThrottle.mbRefresh		= bTexturesChanged || windowThrottle.mbInteracting || elapsed >= windowThrottle.mUpdateInterval || windowThrottle.mDrawListCount != windowThrottle.mSnapshots.Size;
+		windowThrottle.mDrawListIndex	= 0;
+		if( windowThrottle.mbRefresh ){
+			WindowThrottleClear(windowThrottle);
+			windowThrottle.mUpdateTime	= timeNow;
+		}
+	}
+
+	//---------------------------------------------------------------------------------------------
+	// Keep a copy of updated windows content, or replace it with the previous copy
+	//---------------------------------------------------------------------------------------------
+	mWindowThrottleDrawLists.resize(pDearImguiData->CmdListsCount);
+	for(int n = 0; n < pDearImguiData->CmdListsCount; n++)
+	{
+		mWindowThrottleDrawLists[n] = nullptr;
+		if( mWindowThrottleIndices[n] >= 0 ){
+			WindowThrottle& windowThrottle = mWindowThrottles[mWindowThrottleIndices[n]];
+			if( windowThrottle.mbRefresh ){
+				windowThrottle.mSnapshots.push_back(pDearImguiData->CmdLists[n]->CloneOutput());
+			}
+			else {
+				mWindowThrottleDrawLists[n] = windowThrottle.mSnapshots[windowThrottle.mDrawListIndex++];
+			}
+		}
+	}
+	return mWindowThrottleDrawLists.Data;
+}
+
+//=================================================================================================
+// Release the draw lists copy kept by a throttled window
+//=================================================================================================
+void ClientInfo::WindowThrottleClear(WindowThrottle& windowThrottle)
+{
+	for(auto pSnapshot : windowThrottle.mSnapshots){
+		IM_DELETE(pSnapshot);
+	}
+	windowThrottle.mSnapshots.clear();
+}
+
 }}} // namespace NetImgui::Internal::Client
 
 #include "NetImgui_WarningReenable.h"
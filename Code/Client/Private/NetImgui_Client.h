@@ -45,6 +45,45 @@ struct SavedImguiContext
 #endif
 };
 
+//=============================================================================
+// Open addressing hash table of the texture 'Create' commands tracked by the 
+// Client, indexed by their ClientTextureID (linear probing, no tombstone).
+// Note: Removing entries while iterating over the slots is supported, as long
+//		 as the current slot is processed again after a removal
+//=============================================================================
+class TextureTable
+{
+public:
+	CmdTexture*							Find(ClientTextureID clientTextureID)const;
+	CmdTexture*							Insert(CmdTexture& cmdTexture);				// Returns the replaced entry with same ClientTextureID (if any)
+	CmdTexture*							Remove(ClientTextureID clientTextureID);	// Returns the removed entry (if any)
+	void								Clear();
+	inline uint32_t						GetCount()const			{ return mCount; }
+	inline uint32_t						GetSlotCount()const		{ return static_cast<uint32_t>(mSlots.Size); }
+	inline CmdTexture*					GetSlot(uint32_t index)const { return mSlots[static_cast<int>(index)]; }	// nullptr when slot is unused
+
+protected:
+	static constexpr uint32_t			kSlotCountMin = 64;
+	inline uint32_t						GetSlotIndex(ClientTextureID clientTextureID)const;
+	void								Grow();
+	ImVector<CmdTexture*>				mSlots;
+	uint32_t							mCount = 0;
+};
+
+//=============================================================================
+// Stored right after the header of a texture command with user owned pixels
+// (see 'SendDataTextureAsync'). Com thread sends the pixels from 'mpData'
+//=============================================================================
+struct CmdTextureBorrowed
+{
+	static CmdTexture*					Allocate(ClientTextureID clientTexID, const void* pData, uint16_t width, uint16_t height, eTexFormat format, uint32_t dataSize, TextureSentFuncPtr sentFunction, void* pUserData);
+	static inline CmdTextureBorrowed*	Get(CmdTexture& cmdTexture){ return cmdTexture.mPayloadBorrowed ? reinterpret_cast<CmdTextureBorrowed*>(&(&cmdTexture)[1]) : nullptr; }
+	static void							Release(CmdTexture& cmdTexture);	// Let user know its buffer isn't needed anymore (only first call has an effect, thread safe)
+	const uint8_t*						mpData			= nullptr;
+	std::atomic<TextureSentFuncPtr>		mSentFunction;
+	void*								mpUserData		= nullptr;
+};
+
 //=============================================================================
 // Keep all Client infos needed for communication with server
 //=============================================================================
@@ -52,6 +91,31 @@ struct ClientInfo
 {
 	using BufferKeys	= Ringbuffer<uint16_t, 1024>;
 	using TimePoint		= std::chrono::time_point<std::chrono::steady_clock>;
+	static constexpr uint32_t kTextureShareSizeMin = 16*1024;	// Textures with more pixel data than this, are first sent without it (Server might already have it from another client)
+	static constexpr int kDrawFrameRefsMax			= 8;		// Sent DrawFrames kept while waiting on the Server acknowledgment, to be used as delta compression reference
+	static constexpr uint64_t kDrawFrameKeyInterval	= 1800;		// Send an uncompressed DrawFrame (keyframe) at least this often, even when the Server doesn't request one
+	static constexpr uint64_t kDrawFrameExactInterval= 60;		// Send a DrawFrame without ignoring small changes (see 'SetChangeThreshold') at least this often
+	static constexpr float kRedrawSettleTime		= 0.5f;		// With 'kRedrawOnChange', keep drawing this long after a change (in seconds), letting the UI settle
+
+	struct VideoReference
+	{
+		ClientTextureID	mTextureClientID	= 0;
+		uint16_t		mWidth				= 0;
+		uint16_t		mHeight				= 0;
+		uint8_t*		mpPixels			= nullptr;	// RGBA8 content of the entire texture, as last sent to the Server
+	};
+
+	struct WindowThrottle
+	{
+		ImGuiID					mWindowID			= 0;		// Root window with a limited update rate (its child windows follow the same rate)
+		float					mUpdateInterval		= 0.f;		// Minimum time between 2 updates of the window content sent to Server (in seconds)
+		TimePoint				mUpdateTime;					// When the window content was last updated
+		ImVector<ImDrawList*>	mSnapshots;						// Copy of the window draw lists last sent, used instead of new content until next update
+		int						mDrawListCount		= 0;		// Number of draw lists owned by the window this frame
+		int						mDrawListIndex		= 0;		// Next snapshot to use this frame
+		bool					mbInteracting		= false;	// Window is hovered or focused this frame (never throttled)
+		bool					mbRefresh			= false;	// Window content is updated this frame
+	};
 
 	struct InputState
 	{
@@ -75,13 +139,21 @@ struct ClientInfo
 
 	bool 								TextureTrackingAdd(CmdTexture& cmdTexture);
 	bool 								TextureTrackingRem(ClientTextureID cmdTexture);
+	CmdTexture*							TextureTrackingFind(ClientTextureID clientTextureID);
+	void								TextureTrackingAddUpdate(CmdTexture& cmdTexture);
+	void								TextureTrackingRetain();						// Reduce the client copy of textures already sent (see 'SetTextureRetention')
+	uint64_t							TextureTrackingMemoryUsage()const;
+	bool								TextureTrackingUpdateData(ClientTextureID clientTextureID, const void* pData, uint16_t width, uint16_t height, eTexFormat format);	// Send only modified areas of a texture already on Server
+	void								TextureTrackingAddAsync(CmdTexture& cmdTexture);	// Thread safe, texture gets tracked on next 'TextureTrackingUpdate'
 	void 								TextureTrackingClear();
 	void 								TextureTrackingUpdate(bool bResendAll=false);		// Process Backend ImGui textures
 	CmdTexture*							TextureCmdAllocate(ClientTextureID clientTexID, uint16_t width, uint16_t height, eTexFormat format, uint32_t& dataSizeInOut);
 
-	void 								TexturePendingServerAdd(CmdTexture& cmdTexture);	// Add CmdTexture to list of command waiting for send off to Server	
+	bool 								TexturePendingServerAdd(CmdTexture& cmdTexture);	// Add CmdTexture to list of command waiting for send off to Server (false when not connected)
 	
 	void								ProcessDrawData(const ImDrawData* pDearImguiData, ImGuiMouseCursor mouseCursor);
+	const ImDrawList* const*			WindowThrottleUpdate(const ImDrawData* pDearImguiData);	// Draw lists to send instead of the new ones (nullptr entry when not replaced)
+	static void							WindowThrottleClear(WindowThrottle& windowThrottle);
 
 	std::atomic<Network::SocketInfo*>	mpSocketPending;						// Hold socket info until communication is established
 	std::atomic<Network::SocketInfo*>	mpSocketComs;							// Socket used for communications with server
@@ -91,9 +163,26 @@ struct ClientInfo
 	uint32_t							mSocketListenPort			= 0;		// Socket Port number used to wait for communication request from server
 	char								mName[64]					= {};
 	uint64_t							mFrameIndex					= 0;		// Incremented every time we send a DrawFrame Command
+	uint64_t							mFrameIndexAck				= 0;		// Last DrawFrame received by the Server, that it keeps as delta compression reference
+	uint64_t							mFrameIndexKey				= 0;		// Last DrawFrame sent uncompressed (keyframe)
+	uint64_t							mFrameIndexExact			= 0;		// Last DrawFrame sent without ignoring small changes
 	std::mutex							mPendingTexturesLock;					// Lock to prevent thread contention on the list of texure cmd waiting to be sent to the NetImgui Server
 	CmdTexture*							mPendingTextures			= nullptr;	// List of texture commands waiting to be send to Sever (single linked list with oldest item at the head)
-	ImVector<CmdTexture*>				mTrackedTextures;						// List of texture commands to create textures used by this client (note for large texture count, should be replace with a unordered_map for fast operations)
+	std::atomic<CmdTexture*>			mpPendingTexturesAsync;					// Textures added from any thread with user owned pixels, waiting to be tracked by main thread (single linked list with newest item at the head)
+	ImVector<CmdTextureRequest*>		mTextureRequests;						// Textures that Server wants to receive again with their pixel data (protected by 'mPendingTexturesLock')
+	TextureTable						mTrackedTextures;						// Texture commands to create textures used by this client (indexed by ClientTextureID)
+	ImVector<CmdTexture*>				mTrackedTextureCmds;					// Update/Destroy texture commands waiting to be sent, released once done
+	ImVector<ClientTextureID>			mTrackedTexturesRetain;					// Textures waiting to be sent, before their client copy can be reduced (see 'SetTextureRetention')
+	ImVector<ClientTextureID>			mTexturesRefetch;						// Textures without pixel data, that the user must send again
+	ImVector<ClientTextureID>			mTexturesResendManaged;					// Dear ImGui managed textures requested again by Server (released to lower its memory usage)
+	ImVector<VideoReference>			mVideoReferences;						// (Com thread) Last content sent of textures streamed with 'kTexCompressionVideo', needed to encode their next update
+	TextureRefetchFuncPtr				mTextureRefetchFunction		= nullptr;	// User callback sending again a texture without pixel data kept
+	ImVector<WindowThrottle>			mWindowThrottles;						// (Main thread) Windows with a limited update rate (see 'SetWindowUpdateInterval')
+	ImVector<int>						mWindowThrottleIndices;					// (Main thread) Index in 'mWindowThrottles' of each draw list owner, this frame (-1 when not throttled)
+	ImVector<const ImDrawList*>			mWindowThrottleDrawLists;				// (Main thread) Draw lists sent instead of the new content, this frame
+#if NETIMGUI_IMGUI_TEXTURES_ENABLED
+	ImVector<ImTextureData*>			mWindowThrottleTextures;				// (Main thread) Dear ImGui textures when window snapshots were taken
+#endif
 	ExchangePtr<CmdDrawFrame>			mPendingFrameOut;
 	ExchangePtr<CmdBackground>			mPendingBackgroundOut;
 	ExchangePtr<CmdInput>				mPendingInputIn;
@@ -105,17 +194,20 @@ struct ClientInfo
 	CmdPendingRead 						mCmdPendingRead;						// Used to get info on the next incoming command from Server
 	CmdInput*							mpCmdInputPending			= nullptr;	// Last Input Command from server, waiting to be processed by client
 	CmdClipboard*						mpCmdClipboard				= nullptr;	// Last received clipboad command
-	CmdDrawFrame*						mpCmdDrawLast				= nullptr;	// Last sent Draw Command. Used by data compression, to generate delta between previous and current frame
+	ImVector<CmdDrawFrame*>				mCmdDrawRefs;							// Sent Draw Commands that the Server might use for delta compression (oldest first, first one being the current reference)
 	CmdBackground						mBGSetting;								// Current value assigned to background appearance by user
 	CmdBackground						mBGSettingSent;							// Last sent value to remote server
 	BufferKeys							mPendingKeyIn;							// Keys pressed received. Results of 2 CmdInputs are concatenated if received before being processed
 	TimePoint							mLastOutgoingDrawCheckTime;				// When we last checked if we have a pending draw command to send
 	TimePoint							mLastOutgoingDrawTime;					// When we last sent an updated draw command to the server
+	TimePoint							mRedrawSettleTime;						// With 'kRedrawOnChange', keep drawing until this time (after the last change)
+	CmdInput							mInputReceivedPrev;						// (Com thread) Last input received, used to detect changes
 	ImVec2								mSavedDisplaySize			= {0, 0};	// Save original display size on 'NewFrame' and restore it on 'EndFrame' (making sure size is still valid after a disconnect)
 	SavedImguiContext					mSavedContextValues;					// Oiginal ImGui context values that will be restored on disconnect
 	std::atomic_bool					mbClientThreadActive;					// True when connected and communicating with Server
 	std::atomic_bool					mbListenThreadActive;					// True when listening from connection request from Server
 	std::atomic_bool					mbComInitActive;						// True when attempting to initialize a new connection
+	std::atomic_bool					mbRedrawPending;						// A change requires a new frame to be drawn (with 'kRedrawOnChange')
 	bool 								mbTrackedTexturesPending 	= false;	// True if there are some pending tracked textures waiting to be removed
 	bool								mbIsDrawing					= false;	// We are inside a 'NetImgui::NewFrame' / 'NetImgui::EndFrame' (even if not for a remote draw)
 	bool								mbIsRemoteDrawing			= false;	// True if the rendering it meant for the remote netImgui server
@@ -124,8 +216,15 @@ struct ClientInfo
 	bool								mbInsideNewEnd				= false;	// Currently inside NetImgui::NewFrame() or NetImgui::EndFrame() (prevents recusrive hook call)
 	bool								mbValidDrawFrame			= false;	// If we should forward the drawdata to the server at the end of ImGui::Render()
 	uint8_t								mClientCompressionMode		= eCompressionMode::kUseServerSetting;
+	uint8_t								mTextureCompression			= eTexCompression::kTexCompressionLossless;	// Compression applied to textures sent to Server (eTexCompression)
+	uint8_t								mTextureRetention			= eTexRetention::kTexRetentionCopy;			// Texture data kept by Client once sent to Server (eTexRetention)
+	uint8_t								mVertexPrecision			= eVertexPrecision::kVertexPrecisionAuto;	// Storage of the vertices position sent to Server (eVertexPrecision)
+	uint8_t								mChangeThresholdColor		= 0;		// Vertices color changes under this value are ignored (see 'SetChangeThreshold')
+	float								mChangeThresholdPos			= 0.f;		// Vertices position changes under this value are ignored (see 'SetChangeThreshold')
+	uint8_t								mRedrawMode					= eRedrawMode::kRedrawContinuous;	// When new frames are drawn for the Server (eRedrawMode)
+	float								mRedrawHeartbeat			= 1.f;		// With 'kRedrawOnChange', longest delay between 2 frames (in seconds, 0 for none)
 	bool								mServerCompressionEnabled	= false;	// If Server would like compression to be enabled (mClientCompressionMode value can override this value)
-	bool								mServerCompressionSkip		= false;	// Force ignore compression setting for 1 frame
+	bool								mServerCompressionSkip		= false;	// Force ignore compression setting for 1 frame (Server requesting a keyframe)
 	bool 								mServerForceConnectEnabled	= true;		// If another NetImguiServer can take connection away from the one currently active
 	ThreadFunctPtr						mThreadFunction				= nullptr;	// Function to use when laucnhing new threads
 	float								mFontSavedScaling			= 0.f;		// Original Font scaling before our override between NewFrame / EndFrame
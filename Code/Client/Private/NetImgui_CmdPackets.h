@@ -2,6 +2,7 @@
 
 #include "NetImgui_Shared.h"
 #include "NetImgui_CmdPackets_DrawFrame.h"
+#include "NetImgui_CmdPackets_Texture.h"
 
 namespace NetImgui { namespace Internal
 {
@@ -9,7 +10,7 @@ namespace NetImgui { namespace Internal
 //Note: If updating any of these commands data structure, increase 'CmdVersion::eVersion'
 struct alignas(8) CmdHeader
 {
-	enum class eCommands : uint8_t { Version, Texture, Input, DrawFrame, Background, Clipboard, Count };
+	enum class eCommands : uint8_t { Version, Texture, Input, DrawFrame, Background, Clipboard, TextureRequest, Count };
 				CmdHeader(eCommands CmdType, uint16_t Size) : mSize(Size), mType(CmdType){}
 	uint32_t	mSize		= 0;
 	eCommands	mType		= eCommands::Count;
@@ -45,6 +46,15 @@ struct alignas(8) CmdVersion : public CmdHeader
 		UpdatedComs 		= 16,	// Faster protocol by removing blocking coms
 		RemDisconnect		= 17,	// Removed Disconnect command
 		ManagedTextures		= 18, 	// Adding support for Dear Imgui Managed Textures (introduced in 1.92))
+		TextureCompression	= 19,	// Added compressed texture transport formats (lossless LZ, lossy 4x4 blocks)
+		TextureSharing		= 20,	// Added texture content hash, letting Server share identical textures between clients without receiving them again
+		TextureVideo		= 21,	// Added inter-frame texture transport format, for textures refreshed continuously
+		DrawFrameAck		= 22,	// DrawFrames delta compressed against the last one acknowledged by Server, instead of the previous one
+		CompactDraws		= 23,	// DrawGroup draws stored with texture/clip rect palettes, int16 clip rects and varint values
+		VertexPrecision		= 24,	// DrawGroup vertices stored as SoA, with positions precision picked from the group bounding box
+		GlyphRuns			= 25,	// DrawGroup textured quads (text glyphs) sent as glyph table indices with positions and colors
+		SolidRects			= 26,	// DrawGroup solid quads (rectangles using the white pixel) sent with position, size and color
+		ColorPalette		= 27,	// DrawGroup vertices colors can be sent as indices in a palette
 		// Insert new version here
 
 		//--------------------------------
@@ -197,9 +207,10 @@ struct alignas(8) CmdInput : public CmdHeader
 	uint16_t						mKeyChars[256]					= {};		// Input characters		
 	uint16_t						mKeyCharCount					= 0;		// Number of valid input characters
 	bool							mCompressionUse					= false;	// Server would like client to compress the communication data
-	bool							mCompressionSkip				= false;	// Server forcing next client's frame data to be uncompressed
+	bool							mCompressionSkip				= false;	// Server forcing next client's frame data to be uncompressed (keyframe)
 	float							mFontDPIScaling					= 1.f;		// Font scaling request by Server accounting for monitor DPI
 	float 							mDesiredFps						= 30.f;		// Requested redraw speed
+	uint64_t						mFrameIndexAck					= 0;		// Last DrawFrame received by Server, usable as delta compression reference
 	uint64_t						mMouseDownMask					= 0;
 	uint64_t						mInputDownMask[(ImGuiKey_COUNT+63)/64]={};
 	float							mInputAnalog[kAnalog_Count]		= {};
@@ -219,15 +230,29 @@ struct alignas(8) CmdTexture : public CmdHeader
 	uint16_t						mHeight				= 0;							// Either the texture height on create, or the update area height
 	uint16_t 						mOffsetX			= 0;							// Used by partial update
 	uint16_t 						mOffsetY			= 0;							// Used by partial update
-	uint8_t							PADDING[4]			= {};
+	uint8_t							mPayloadSkipped		= false;						// Pixel data not included, Server should use its texture with the same 'mContentHash'
+	uint8_t							mPayloadRequired	= false;						// (Client only) Server doesn't have this content, always include the pixel data
+	uint8_t							mPayloadReleased	= false;						// (Client only) Pixel data not kept by Client anymore, must be refetched from user (see 'SetTextureRetention')
+	uint8_t							mPayloadBorrowed	= false;						// (Client only) Pixel data not owned by this command, but by the user (see 'SendDataTextureAsync')
+	uint64_t						mContentHash		= 0;							// Hash of the texture content (0 when not shareable between clients)
 	alignas(8) CmdTexture*			mpNext				= nullptr;						// Used for single linked list of pending textures (alignas needed to keep class size the same between win32/x64)
 	OffsetPointer<uint8_t>			mpTextureData;
 };
 
+// Sent by Server after receiving a texture without its pixel data that it doesn't have, 
+// or when needing again a texture it released to lower its memory usage (mContentHash = 0)
+struct alignas(8) CmdTextureRequest : public CmdHeader
+{
+	CmdTextureRequest() : CmdHeader(CmdHeader::eCommands::TextureRequest, sizeof(CmdTextureRequest)){}
+	ClientTextureID					mTextureClientID	= 0;
+	uint64_t						mContentHash		= 0;
+};
+
 struct alignas(8) CmdDrawFrame : public CmdHeader
 {
 	CmdDrawFrame() : CmdHeader(CmdHeader::eCommands::DrawFrame, sizeof(CmdDrawFrame)){}
 	uint64_t						mFrameIndex			= 0;
+	uint64_t						mFrameIndexRef		= 0;	// DrawFrame used as delta compression reference (when 'mCompressed')
 	uint32_t						mMouseCursor		= 0;	// ImGuiMouseCursor value
 	float							mDisplayArea[4]		= {};
 	uint32_t						mIndiceByteSize		= 0;
@@ -269,14 +294,17 @@ struct alignas(8) CmdClipboard : public CmdHeader
 //=============================================================================
 struct PendingCom
 {
-	size_t SizeCurrent	= 0;		// Amount of data sent or received so far
-	bool bAutoFree		= false;	// Need to free data buffer at the end of processing
-	bool bError			= false;	// If an error occurs during coms
-	CmdHeader* pCommand	= nullptr;	// Where to store incoming data or read to send data
+	size_t SizeCurrent		= 0;		// Amount of data sent or received so far
+	bool bAutoFree			= false;	// Need to free data buffer at the end of processing
+	bool bError				= false;	// If an error occurs during coms
+	CmdHeader* pCommand		= nullptr;	// Where to store incoming data or read to send data
+	const uint8_t* pPayload	= nullptr;	// (Send only, optional) Command data past 'PayloadOffset' is read from this buffer instead (user owned texture pixels)
+	size_t PayloadOffset	= 0;
 	inline bool IsError()const{ return bError; }
 	inline bool IsDone()const { return IsError() || (pCommand && pCommand->mSize == SizeCurrent); }
 	inline bool IsReady()const{ return !IsError() && pCommand == nullptr; }	
 	inline bool IsPending()const{ return !IsError() && !IsDone() && !IsReady(); }
+	inline const uint8_t* GetSendData(size_t sizeMax, size_t& sizeOut)const;	// Next contiguous data to send (network backends must use this)
 };
 
 }} // namespace NetImgui::Internal
@@ -32,6 +32,7 @@ void ImguiDrawGroup::ToPointers()
 		mpIndices.ToPointer();
 		mpVertices.ToPointer();
 		mpDraws.ToPointer();
+		mpPrimitives.ToPointer();
 	}
 }
 
@@ -42,6 +43,7 @@ void ImguiDrawGroup::ToOffsets()
 		mpIndices.ToOffset();
 		mpVertices.ToOffset();
 		mpDraws.ToOffset();
+		mpPrimitives.ToOffset();
 	}
 }
 
@@ -98,4 +100,12 @@ CmdClipboard* CmdClipboard::Create(const char* clipboard)
 	return nullptr;
 }
 
+const uint8_t* PendingCom::GetSendData(size_t sizeMax, size_t& sizeOut)const
+{
+	const bool bHeader		= pPayload == nullptr || SizeCurrent < PayloadOffset;
+	size_t sizeRemaining	= (bHeader && pPayload ? PayloadOffset : pCommand->mSize) - SizeCurrent;
+	sizeOut					= sizeRemaining < sizeMax ? sizeRemaining : sizeMax;
+	return bHeader ? &reinterpret_cast<const uint8_t*>(pCommand)[SizeCurrent] : &pPayload[SizeCurrent - PayloadOffset];
+}
+
 }} // namespace NetImgui::Internal
@@ -4,6 +4,13 @@
 #include "NetImgui_WarningDisable.h"
 #include "NetImgui_CmdPackets.h"
 
+// Vertices decoding 4 at a time, when SSE2 is available and Dear ImGui uses the default vertex layout
+#if defined(IMGUI_ENABLE_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+	#define NETIMGUI_DECODE_SSE2 1
+#else
+	#define NETIMGUI_DECODE_SSE2 0
+#endif
+
 namespace NetImgui { namespace Internal
 {
 
@@ -12,96 +19,827 @@ inline void SetAndIncreaseDataPointer(OffsetPointer<TType>& dataPointer, uint32_
 {
 	dataPointer.SetComDataPtr(pDataOutput);
 	const size_t dataCount		= DivUp<size_t>(dataSize, ComDataSize);
-	pDataOutput[dataCount-1]	= 0;
+	if( dataCount > 0 ){
+		pDataOutput[dataCount-1]= 0;
+	}
 	pDataOutput					+= dataCount;
 }
 
-//=============================================================================
-// Safely convert a pointer to a int value, even if int storage size > pointer
-//=============================================================================
-template<typename TInt, typename TPointer>
-TInt PointerCast(TPointer* pointer)
+//=================================================================================================
+// Variable length integer encoding (7bits per byte, high bit set when more bytes follow)
+//=================================================================================================
+inline void WriteVarint(uint8_t*& pOutput, uint64_t value)
+{
+	while( value >= 0x80 ){
+		*pOutput++	= static_cast<uint8_t>(value | 0x80);
+		value		>>= 7;
+	}
+	*pOutput++ = static_cast<uint8_t>(value);
+}
+
+inline bool ReadVarint(const uint8_t*& pInput, const uint8_t* pInputEnd, uint64_t& valueOut)
+{
+	valueOut = 0;
+	for(uint32_t shift(0); shift < 64 && pInput < pInputEnd; shift += 7){
+		const uint8_t value	= *pInput++;
+		valueOut			|= static_cast<uint64_t>(value & 0x7F) << shift;
+		if( (value & 0x80) == 0 ){
+			return true;
+		}
+	}
+	return false;
+}
+
+inline uint64_t ZigZagEncode(int64_t value)		{ return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63); }
+inline int64_t ZigZagDecode(uint64_t value)		{ return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1); }
+
+//=================================================================================================
+// Vertices are saved as 3 arrays (colors, UVs, positions). Positions precision is picked per 
+// DrawGroup from its bounding box : the finest quantization fitting 8 or 16bits integers, 
+// or float when even 16bits can't keep the minimum precision.
+// Colors are replaced by indices in a palette of the group colors, when it is smaller
+//=================================================================================================
+struct VertexArraysLayout
+{
+	VertexArraysLayout(eVertPosFormat posFormat, eVertColorFormat colorFormat, uint64_t vtxCount, uint64_t paletteCount)
+	{
+		const uint64_t posSize		= posFormat == eVertPosFormat::Int8 ? 1 : posFormat == eVertPosFormat::Int16 ? 2 : 4;
+		const uint64_t colorSize	= colorFormat == eVertColorFormat::Palette8 ? 1 : colorFormat == eVertColorFormat::Palette16 ? 2 : 4;
+		const bool isPalette		= colorFormat != eVertColorFormat::Direct;
+		mUVsOffset					= RoundUp<uint64_t>(vtxCount * colorSize, 4);
+		mPositionsOffset			= mUVsOffset + vtxCount * 2 * sizeof(uint16_t);
+		mPaletteOffset				= mPositionsOffset + (isPalette ? RoundUp<uint64_t>(vtxCount * 2 * posSize, 4) : vtxCount * 2 * posSize);
+		mByteSize					= mPaletteOffset + (isPalette ? (paletteCount + 1) * sizeof(uint32_t) : 0);
+	}
+	uint64_t mUVsOffset;
+	uint64_t mPositionsOffset;
+	uint64_t mPaletteOffset;
+	uint64_t mByteSize;
+};
+
+inline uint16_t ImGui_QuantizeUV(float value)
+{
+	return static_cast<uint16_t>((value - static_cast<float>(ImguiDrawGroup::kUvRange_Min) + 0.5f/65535.f) * 0xFFFF / (ImguiDrawGroup::kUvRange_Max - ImguiDrawGroup::kUvRange_Min));
+}
+
+inline float DecodeUV(uint16_t value)
+{
+	constexpr float kUVRangeMin	= static_cast<float>(ImguiDrawGroup::kUvRange_Min);
+	constexpr float kUVRangeMax	= static_cast<float>(ImguiDrawGroup::kUvRange_Max);
+	return (static_cast<float>(value) * (kUVRangeMax - kUVRangeMin)) / static_cast<float>(0xFFFF) + kUVRangeMin;
+}
+
+inline uint32_t ImGui_QuantizePos(float value, float referenceCoord, float posScale)
+{
+	return static_cast<uint32_t>((value - referenceCoord) * posScale + 0.5f);
+}
+
+//=================================================================================================
+// Textured quads (4 vertices, 6 indices, axis aligned, same color) are what Dear ImGui emits
+// for each text glyph. They are removed from the vertices/indices arrays and sent as an index
+// in a table of unique UVs/size, with their position and color (see 'ImguiDrawGroup::mpPrimitives')
+// Solid quads (sampling the font atlas white pixel) are used for rectangles (backgrounds, 
+// table cells, plot bars, ...) and sent with their position, size and color instead
+//=================================================================================================
+struct QuadGlyph
+{
+	uint16_t	mUV[4];
+	int16_t		mSize[2];
+	inline bool operator==(const QuadGlyph& cmp)const { return memcmp(this, &cmp, sizeof(QuadGlyph)) == 0; }
+};
+
+struct GeometryEncoder
+{
+	static constexpr size_t		kQuadSizeMax		= 5+4*10+4 + sizeof(QuadGlyph) + 4*10;	// Quad record + new glyph + new segment
+	ImVector<int>				mVertices;			// Vertices kept in the regular arrays
+	ImVector<uint32_t>			mIndices;			// Indices kept in the regular array
+	ImVector<QuadGlyph>			mGlyphs;
+	ImGuiStorage				mGlyphLookup;		// Glyph hash -> 'mGlyphs' index + 1
+	ImVector<uint8_t>			mSegments;
+	ImVector<uint8_t>			mQuads;				// Quads records of the segment in progress
+	uint32_t					mSegmentVtxCount	= 0;
+	uint32_t					mSegmentIdxCount	= 0;
+	uint32_t					mSegmentQuadCount	= 0;
+	uint32_t					mSegmentQuadVtxOffset = 0;
+	int64_t						mQuadPrevPos[2]		= {};
+	uint32_t					mQuadPrevColor		= 0;
+	uint16_t					mSolidUV[2]			= {};	// UV of the font atlas white pixel (first solid quad found)
+	bool						mbSolidUV			= false;
+	ImVector<uint32_t>			mPalette;
+	ImVector<uint16_t>			mColorIndices;		// Palette index of each vertex kept in the regular arrays
+	ImVector<int>				mPaletteTable;		// Color hash table -> 'mPalette' index + 1
+};
+
+inline void ImGui_FlushSegment(GeometryEncoder& encoder)
+{
+	const int recordsSize = static_cast<int>(encoder.mQuads.size());
+	const int segmentStart= encoder.mSegments.size();
+	encoder.mSegments.resize(segmentStart + 4*10 + recordsSize);
+	uint8_t* pOutput = &encoder.mSegments[segmentStart];
+	WriteVarint(pOutput, encoder.mSegmentVtxCount);
+	WriteVarint(pOutput, encoder.mSegmentIdxCount);
+	WriteVarint(pOutput, encoder.mSegmentQuadCount);
+	if( encoder.mSegmentQuadCount > 0 ){
+		WriteVarint(pOutput, encoder.mSegmentQuadVtxOffset);
+		memcpy(pOutput, encoder.mQuads.Data, static_cast<size_t>(recordsSize));
+		pOutput += recordsSize;
+	}
+	encoder.mSegments.resize(static_cast<int>(pOutput - encoder.mSegments.Data));
+	encoder.mQuads.resize(0);
+	encoder.mSegmentVtxCount = encoder.mSegmentIdxCount = encoder.mSegmentQuadCount = 0;
+}
+
+// Try adding the quad made of vertices [vtxIdx, vtxIdx+3] and indices [idxIdx, idxIdx+5]
+inline bool ImGui_ExtractQuad(const ImDrawList& cmdList, const ImguiDrawGroup& drawGroup, int vtxIdx, int idxIdx, uint32_t vtxOffset, GeometryEncoder& encoder)
+{
+	const ImDrawIdx* pIdx	= &cmdList.IdxBuffer[idxIdx];
+	const ImDrawVert* pVtx	= &cmdList.VtxBuffer[vtxIdx];
+	if( static_cast<uint32_t>(pIdx[0]) + vtxOffset != static_cast<uint32_t>(vtxIdx) ||
+		pIdx[1] != pIdx[0]+1 || pIdx[2] != pIdx[0]+2 || pIdx[3] != pIdx[0] || pIdx[4] != pIdx[0]+2 || pIdx[5] != pIdx[0]+3 ||
+		pVtx[1].col != pVtx[0].col || pVtx[2].col != pVtx[0].col || pVtx[3].col != pVtx[0].col ){
+		return false;
+	}
+
+	// Must be axis aligned once quantized : [0]=(x0,y0) [1]=(x1,y0) [2]=(x1,y1) [3]=(x0,y1)
+	uint32_t pos[4][2];
+	uint16_t uv[4][2];
+	for(int i(0); i < 4; ++i){
+		pos[i][0]	= ImGui_QuantizePos(pVtx[i].pos.x, drawGroup.mReferenceCoord[0], drawGroup.mPosScale);
+		pos[i][1]	= ImGui_QuantizePos(pVtx[i].pos.y, drawGroup.mReferenceCoord[1], drawGroup.mPosScale);
+		uv[i][0]	= ImGui_QuantizeUV(pVtx[i].uv.x);
+		uv[i][1]	= ImGui_QuantizeUV(pVtx[i].uv.y);
+	}
+	const int64_t sizeX = static_cast<int64_t>(pos[2][0]) - static_cast<int64_t>(pos[0][0]);
+	const int64_t sizeY = static_cast<int64_t>(pos[2][1]) - static_cast<int64_t>(pos[0][1]);
+	if( pos[1][0] != pos[2][0] || pos[1][1] != pos[0][1] || pos[3][0] != pos[0][0] || pos[3][1] != pos[2][1] ||
+		uv[1][0] != uv[2][0] || uv[1][1] != uv[0][1] || uv[3][0] != uv[0][0] || uv[3][1] != uv[2][1] ){
+		return false;
+	}
+
+	// Solid rectangle, all vertices using the white pixel UV
+	if( !encoder.mbSolidUV && uv[0][0] == uv[2][0] && uv[0][1] == uv[2][1] ){
+		encoder.mSolidUV[0]	= uv[0][0];
+		encoder.mSolidUV[1]	= uv[0][1];
+		encoder.mbSolidUV	= true;
+	}
+	const bool isSolid			= encoder.mbSolidUV && uv[0][0] == encoder.mSolidUV[0] && uv[0][1] == encoder.mSolidUV[1] && uv[2][0] == encoder.mSolidUV[0] && uv[2][1] == encoder.mSolidUV[1];
+
+	// Find the glyph in table (usually less than a hundred different ones)
+	int glyphIdx				= -1;
+	if( !isSolid )
+	{
+		if( sizeX < -32768 || sizeX > 32767 || sizeY < -32768 || sizeY > 32767 ){
+			return false;
+		}
+		const QuadGlyph glyph	= {{uv[0][0], uv[0][1], uv[2][0], uv[2][1]}, {static_cast<int16_t>(sizeX), static_cast<int16_t>(sizeY)}};
+		const ImGuiID glyphHash	= ImHashData(&glyph, sizeof(glyph));
+		glyphIdx				= encoder.mGlyphLookup.GetInt(glyphHash) - 1;
+		if( glyphIdx < 0 || !(encoder.mGlyphs[glyphIdx] == glyph) ){
+			glyphIdx = encoder.mGlyphs.size();
+			encoder.mGlyphs.push_back(glyph);
+			encoder.mGlyphLookup.SetInt(glyphHash, glyphIdx + 1);
+		}
+	}
+
+	// Quads of a segment share the same index to vertex offset
+	if( encoder.mSegmentQuadCount > 0 && encoder.mSegmentQuadVtxOffset != vtxOffset ){
+		ImGui_FlushSegment(encoder);
+	}
+	const bool colorChanged		= pVtx[0].col != encoder.mQuadPrevColor;
+	const int recordStart		= encoder.mQuads.size();
+	encoder.mQuads.resize(recordStart + 5+4*10+4);
+	uint8_t* pOutput			= &encoder.mQuads[recordStart];
+	WriteVarint(pOutput, (static_cast<uint64_t>(glyphIdx + 1) << 1) | (colorChanged ? 1 : 0));
+	WriteVarint(pOutput, ZigZagEncode(static_cast<int64_t>(pos[0][0]) - encoder.mQuadPrevPos[0]));
+	WriteVarint(pOutput, ZigZagEncode(static_cast<int64_t>(pos[0][1]) - encoder.mQuadPrevPos[1]));
+	if( isSolid ){
+		WriteVarint(pOutput, ZigZagEncode(sizeX));
+		WriteVarint(pOutput, ZigZagEncode(sizeY));
+	}
+	if( colorChanged ){
+		memcpy(pOutput, &pVtx[0].col, sizeof(uint32_t));
+		pOutput += sizeof(uint32_t);
+	}
+	encoder.mQuads.resize(static_cast<int>(pOutput - encoder.mQuads.Data));
+	encoder.mSegmentQuadVtxOffset	= vtxOffset;
+	encoder.mQuadPrevPos[0]			= static_cast<int64_t>(pos[2][0]);	// Next glyph usually starts right after this one
+	encoder.mQuadPrevPos[1]			= static_cast<int64_t>(pos[0][1]);
+	encoder.mQuadPrevColor			= pVtx[0].col;
+	++encoder.mSegmentQuadCount;
+	return true;
+}
+
+//=================================================================================================
+// Split the DrawList geometry between the quads sent as primitives, and the remaining
+// vertices/indices sent as is. Vertices order is preserved, letting the Server rebuild 
+// the exact same buffers
+//=================================================================================================
+inline uint32_t ImGui_ExtractQuads(const ImDrawList& cmdList, const ImguiDrawGroup& drawGroup, GeometryEncoder& encoder)
+{
+	const int vtxCount			= cmdList.VtxBuffer.size();
+	const int idxCount			= cmdList.IdxBuffer.size();
+	uint32_t quadCount			= 0;
+	int vtxIdx					= 0;
+	int idxIdx					= 0;
+	encoder.mVertices.resize(0);
+	encoder.mIndices.resize(0);
+	encoder.mGlyphs.resize(0);
+	encoder.mGlyphLookup.Clear();
+	encoder.mSegments.resize(0);
+	encoder.mQuads.resize(0);
+	encoder.mSegmentVtxCount	= encoder.mSegmentIdxCount = encoder.mSegmentQuadCount = 0;
+	encoder.mQuadPrevPos[0]		= encoder.mQuadPrevPos[1] = 0;
+	encoder.mQuadPrevColor		= 0;
+	encoder.mbSolidUV			= false;
+
+	// Need the index to vertex offset of each index, only handle drawcalls covering the index buffer in order
+	bool bValidDraws			= drawGroup.mPosFormat != eVertPosFormat::Float;
+	for(int cmd_i = 0, idxOffsetNext = 0; cmd_i < cmdList.CmdBuffer.size() && bValidDraws; ++cmd_i){
+		const ImDrawCmd& cmd = cmdList.CmdBuffer[cmd_i];
+	#if IMGUI_VERSION_NUM >= 17100
+		bValidDraws		= cmd.UserCallback != nullptr || static_cast<int>(cmd.IdxOffset) == idxOffsetNext;
+	#endif
+		idxOffsetNext	+= cmd.UserCallback == nullptr ? static_cast<int>(cmd.ElemCount) : 0;
+		bValidDraws		&= idxOffsetNext <= idxCount && (cmd_i + 1 < cmdList.CmdBuffer.size() || idxOffsetNext == idxCount);
+	}
+
+	for(int cmd_i = 0; cmd_i < cmdList.CmdBuffer.size() && bValidDraws; ++cmd_i)
+	{
+		const ImDrawCmd& cmd	= cmdList.CmdBuffer[cmd_i];
+		if( cmd.UserCallback != nullptr ){
+			continue;
+		}
+	#if IMGUI_VERSION_NUM >= 17100
+		const uint32_t vtxOffset = cmd.VtxOffset;
+	#else
+		const uint32_t vtxOffset = 0;
+	#endif
+		const int idxEnd = idxIdx + static_cast<int>(cmd.ElemCount);
+		while( idxIdx < idxEnd )
+		{
+			if( idxIdx + 6 <= idxEnd && vtxIdx + 4 <= vtxCount && ImGui_ExtractQuad(cmdList, drawGroup, vtxIdx, idxIdx, vtxOffset, encoder) ){
+				vtxIdx += 4;
+				idxIdx += 6;
+				++quadCount;
+				continue;
+			}
+
+			// Regular triangle, also keep the vertices it uses that haven't been added yet
+			if( encoder.mSegmentQuadCount > 0 ){
+				ImGui_FlushSegment(encoder);
+			}
+			for(int triEnd = ImMin(idxIdx + 3, idxEnd); idxIdx < triEnd; ++idxIdx){
+				const uint32_t index	= static_cast<uint32_t>(cmdList.IdxBuffer[idxIdx]);
+				const int vtxEnd		= static_cast<int>(ImMin(index + vtxOffset + 1, static_cast<uint32_t>(vtxCount)));
+				for(; vtxIdx < vtxEnd; ++vtxIdx, ++encoder.mSegmentVtxCount){
+					encoder.mVertices.push_back(vtxIdx);
+				}
+				encoder.mIndices.push_back(index);
+				++encoder.mSegmentIdxCount;
+			}
+		}
+	}
+
+	// Remaining content (or everything, when not using quads)
+	if( quadCount == 0 ){
+		vtxIdx = idxIdx = 0;
+		encoder.mVertices.resize(0);
+		encoder.mIndices.resize(0);
+	}
+	// Segment regular vertices are decoded before its quads, remaining vertices must start a new one
+	if( encoder.mSegmentQuadCount > 0 && (vtxIdx < vtxCount || idxIdx < idxCount) ){
+		ImGui_FlushSegment(encoder);
+	}
+	for(; vtxIdx < vtxCount; ++vtxIdx, ++encoder.mSegmentVtxCount){
+		encoder.mVertices.push_back(vtxIdx);
+	}
+	for(; idxIdx < idxCount; ++idxIdx, ++encoder.mSegmentIdxCount){
+		encoder.mIndices.push_back(static_cast<uint32_t>(cmdList.IdxBuffer[idxIdx]));
+	}
+	if( quadCount > 0 ){
+		ImGui_FlushSegment(encoder);
+	}
+	return quadCount;
+}
+
+//=================================================================================================
+// Find the colors of the vertices kept in the regular arrays, and pick the smallest storage.
+// Stops as soon as the palette gets too big to be worth it (open addressing hash table)
+//=================================================================================================
+inline eVertColorFormat ImGui_ExtractPalette(const ImDrawList& cmdList, eVertPosFormat posFormat, GeometryEncoder& encoder)
 {
-	union CastHelperUnion
+	const int vtxCount			= encoder.mVertices.size();
+	const int paletteMax		= ImMin(vtxCount / 2, 0x10000);
+	int tableSize				= 16;
+	while( tableSize < paletteMax * 2 ){
+		tableSize *= 2;
+	}
+	const uint32_t tableMask	= static_cast<uint32_t>(tableSize - 1);
+	encoder.mPalette.resize(0);
+	encoder.mColorIndices.resize(vtxCount);
+	encoder.mPaletteTable.resize(tableSize);
+	memset(encoder.mPaletteTable.Data, 0, static_cast<size_t>(tableSize) * sizeof(int));
+	for(int i(0); i < vtxCount; ++i)
 	{
-		TInt		ValueInt;
-		TPointer*	ValuePointer;
-	};
-	CastHelperUnion helperObject = {};
-	helperObject.ValuePointer = pointer;
-	return helperObject.ValueInt;
+		const uint32_t color	= cmdList.VtxBuffer[encoder.mVertices[i]].col;
+		uint32_t slot			= ((color * 2654435761u) >> 16) & tableMask;
+		int paletteIdx			= encoder.mPaletteTable[static_cast<int>(slot)] - 1;
+		while( paletteIdx >= 0 && encoder.mPalette[paletteIdx] != color ){
+			slot		= (slot + 1) & tableMask;
+			paletteIdx	= encoder.mPaletteTable[static_cast<int>(slot)] - 1;
+		}
+		if( paletteIdx < 0 ){
+			if( encoder.mPalette.size() >= paletteMax ){
+				return eVertColorFormat::Direct;
+			}
+			paletteIdx = encoder.mPalette.size();
+			encoder.mPalette.push_back(color);
+			encoder.mPaletteTable[static_cast<int>(slot)] = paletteIdx + 1;
+		}
+		encoder.mColorIndices[i] = static_cast<uint16_t>(paletteIdx);
+	}
+
+	const uint64_t paletteCount		= static_cast<uint64_t>(encoder.mPalette.size());
+	const eVertColorFormat palette	= paletteCount <= 0x100 ? eVertColorFormat::Palette8 : eVertColorFormat::Palette16;
+	const uint64_t paletteSize		= VertexArraysLayout(posFormat, palette, static_cast<uint64_t>(vtxCount), paletteCount).mByteSize;
+	const uint64_t directSize		= VertexArraysLayout(posFormat, eVertColorFormat::Direct, static_cast<uint64_t>(vtxCount), 0).mByteSize;
+	return paletteSize < directSize ? palette : eVertColorFormat::Direct;
 }
 
 //=================================================================================================
 // 
 //=================================================================================================
-inline void ImGui_ExtractIndices(const ImDrawList& cmdList, ImguiDrawGroup& drawGroupOut, ComDataType*& pDataOutput)
+inline void ImGui_ExtractIndices(const ImDrawList& cmdList, ImguiDrawGroup& drawGroupOut, ComDataType*& pDataOutput, const GeometryEncoder& encoder)
 {
 	bool is16Bit					= sizeof(ImDrawIdx) == 2 || cmdList.VtxBuffer.size() <= 0xFFFF;	// When Dear Imgui is compiled with ImDrawIdx = uint16, we know for certain that there won't be any drawcall with index > 65k, even if Vertex buffer is bigger than 65k.
 	drawGroupOut.mBytePerIndex		= is16Bit ? 2 : 4;
 	drawGroupOut.mIndiceCount		= static_cast<uint32_t>(cmdList.IdxBuffer.size());
-	uint32_t sizeNeeded				= drawGroupOut.mIndiceCount*drawGroupOut.mBytePerIndex;
-	SetAndIncreaseDataPointer(drawGroupOut.mpIndices, sizeNeeded, pDataOutput);
+	SetAndIncreaseDataPointer(drawGroupOut.mpIndices, drawGroupOut.GetIndexByteSize(), pDataOutput);
 
-	// No conversion needed, straight copy
-	if( drawGroupOut.mBytePerIndex == sizeof(ImDrawIdx) )
+	// No quads and no conversion needed, straight copy
+	if( drawGroupOut.mQuadCount == 0 && drawGroupOut.mBytePerIndex == sizeof(ImDrawIdx) )
 	{
-		memcpy(drawGroupOut.mpIndices.Get(), &cmdList.IdxBuffer.front(), sizeNeeded);
+		memcpy(drawGroupOut.mpIndices.Get(), cmdList.IdxBuffer.Data, drawGroupOut.GetIndexByteSize());
 	}
-	// From 32bits to 16bits
 	else if(is16Bit)
 	{
-	 	for(int i(0); i < static_cast<int>(drawGroupOut.mIndiceCount); ++i)
-	 		reinterpret_cast<uint16_t*>(drawGroupOut.mpIndices.Get())[i] = static_cast<uint16_t>(cmdList.IdxBuffer[i]);
+	 	for(int i(0); i < encoder.mIndices.size(); ++i)
+	 		reinterpret_cast<uint16_t*>(drawGroupOut.mpIndices.Get())[i] = static_cast<uint16_t>(encoder.mIndices[i]);
 	}
-	// From 16bits to 32bits
 	else
 	{
-		for(int i(0); i < static_cast<int>(drawGroupOut.mIndiceCount); ++i)
-	 		reinterpret_cast<uint32_t*>(drawGroupOut.mpIndices.Get())[i] = static_cast<uint32_t>(cmdList.IdxBuffer[i]);
+		memcpy(drawGroupOut.mpIndices.Get(), encoder.mIndices.Data, drawGroupOut.GetIndexByteSize());
+	}
+}
+
+template <typename TPosType>
+inline void ImGui_ExtractPositions(const ImDrawList& cmdList, const ImguiDrawGroup& drawGroup, const GeometryEncoder& encoder, TPosType* pPositions)
+{
+	for(int i(0); i<encoder.mVertices.size(); ++i)
+	{
+		const auto& Vtx			= cmdList.VtxBuffer[encoder.mVertices[i]];
+		pPositions[i*2+0]		= static_cast<TPosType>(ImGui_QuantizePos(Vtx.pos.x, drawGroup.mReferenceCoord[0], drawGroup.mPosScale));
+		pPositions[i*2+1]		= static_cast<TPosType>(ImGui_QuantizePos(Vtx.pos.y, drawGroup.mReferenceCoord[1], drawGroup.mPosScale));
+	}
+}
+
+template <>
+inline void ImGui_ExtractPositions(const ImDrawList& cmdList, const ImguiDrawGroup&, const GeometryEncoder& encoder, float* pPositions)
+{
+	for(int i(0); i<encoder.mVertices.size(); ++i)
+	{
+		const auto& Vtx			= cmdList.VtxBuffer[encoder.mVertices[i]];
+		pPositions[i*2+0]		= Vtx.pos.x;
+		pPositions[i*2+1]		= Vtx.pos.y;
+	}
+}
+
+inline void ImGui_ExtractVertices(const ImDrawList& cmdList, ImguiDrawGroup& drawGroupOut, ComDataType*& pDataOutput, eVertexPrecision vertexPrecision, GeometryEncoder& encoder)
+{
+	drawGroupOut.mVerticeCount		= static_cast<uint32_t>(cmdList.VtxBuffer.size());
+
+	// Find the positions bounding box, and pick the storage fitting it
+	ImVec2 posMin(0.f, 0.f), posMax(0.f, 0.f);
+	if( drawGroupOut.mVerticeCount > 0 ){
+		posMin = posMax = cmdList.VtxBuffer[0].pos;
+		for(int i(1); i<static_cast<int>(drawGroupOut.mVerticeCount); ++i){
+			posMin = ImMin(posMin, cmdList.VtxBuffer[i].pos);
+			posMax = ImMax(posMax, cmdList.VtxBuffer[i].pos);
+		}
+	}
+	const float posRange			= ImMax(posMax.x - posMin.x, posMax.y - posMin.y);
+	drawGroupOut.mReferenceCoord[0] = posMin.x;
+	drawGroupOut.mReferenceCoord[1] = posMin.y;
+	drawGroupOut.mPosFormat			= eVertPosFormat::Float;
+	drawGroupOut.mPosScale			= 1.f;
+	if( vertexPrecision == eVertexPrecision::kVertexPrecisionAuto )
+	{
+		const eVertPosFormat kFormats[]		= {eVertPosFormat::Int8, eVertPosFormat::Int16};
+		const float kFormatsValueMax[]		= {255.f, 65535.f};
+		for(int i(0); i < 2 && drawGroupOut.mPosFormat == eVertPosFormat::Float; ++i){
+			if( posRange * ImguiDrawGroup::kPosScaleMin <= kFormatsValueMax[i] ){
+				float posScale = ImguiDrawGroup::kPosScaleMin;
+				while( posScale < ImguiDrawGroup::kPosScaleMax && posRange * posScale * 2.f <= kFormatsValueMax[i] ){
+					posScale *= 2.f;
+				}
+				drawGroupOut.mPosFormat	= kFormats[i];
+				drawGroupOut.mPosScale	= posScale;
+			}
+		}
+	}
+	// Float positions are saved as is
+	if( drawGroupOut.mPosFormat == eVertPosFormat::Float ){
+		drawGroupOut.mReferenceCoord[0] = drawGroupOut.mReferenceCoord[1] = 0.f;
+	}
+
+	// Quads are only sent as primitives with integer positions
+	drawGroupOut.mQuadCount			= ImGui_ExtractQuads(cmdList, drawGroupOut, encoder);
+
+	const uint32_t vtxCount			= static_cast<uint32_t>(encoder.mVertices.size());
+	drawGroupOut.mColorFormat		= ImGui_ExtractPalette(cmdList, drawGroupOut.mPosFormat, encoder);
+	const uint32_t paletteCount		= drawGroupOut.mColorFormat == eVertColorFormat::Direct ? 0 : static_cast<uint32_t>(encoder.mPalette.size());
+	const VertexArraysLayout layout(drawGroupOut.mPosFormat, drawGroupOut.mColorFormat, vtxCount, paletteCount);
+	drawGroupOut.mVertexByteSize	= static_cast<uint32_t>(layout.mByteSize);
+	SetAndIncreaseDataPointer(drawGroupOut.mpVertices, drawGroupOut.mVertexByteSize, pDataOutput);
+	uint8_t* pVertices				= drawGroupOut.mpVertices.Get();
+	uint16_t* pUVs					= reinterpret_cast<uint16_t*>(pVertices + layout.mUVsOffset);
+	void* pPositions				= pVertices + layout.mPositionsOffset;
+	switch( drawGroupOut.mColorFormat )
+	{
+	case eVertColorFormat::Direct:
+		for(int i(0); i<static_cast<int>(vtxCount); ++i){
+			reinterpret_cast<uint32_t*>(pVertices)[i] = cmdList.VtxBuffer[encoder.mVertices[i]].col;
+		}
+		break;
+	case eVertColorFormat::Palette8:
+	case eVertColorFormat::Palette16:
+		memset(pVertices, 0, drawGroupOut.mVertexByteSize); // Clear the arrays padding
+		if( drawGroupOut.mColorFormat == eVertColorFormat::Palette16 ){
+			memcpy(pVertices, encoder.mColorIndices.Data, vtxCount * sizeof(uint16_t));
+		}
+		else{
+			for(int i(0); i<static_cast<int>(vtxCount); ++i){
+				pVertices[i] = static_cast<uint8_t>(encoder.mColorIndices[i]);
+			}
+		}
+		memcpy(pVertices + layout.mPaletteOffset, encoder.mPalette.Data, paletteCount * sizeof(uint32_t));
+		memcpy(pVertices + layout.mPaletteOffset + paletteCount * sizeof(uint32_t), &paletteCount, sizeof(uint32_t));
+		break;
+	}
+
+	for(int i(0); i<static_cast<int>(vtxCount); ++i)
+	{
+		const auto& Vtx			= cmdList.VtxBuffer[encoder.mVertices[i]];
+		pUVs[i*2+0]				= ImGui_QuantizeUV(Vtx.uv.x);
+		pUVs[i*2+1]				= ImGui_QuantizeUV(Vtx.uv.y);
+	}
+
+	switch( drawGroupOut.mPosFormat )
+	{
+	case eVertPosFormat::Int8:	ImGui_ExtractPositions(cmdList, drawGroupOut, encoder, reinterpret_cast<uint8_t*>(pPositions)); break;
+	case eVertPosFormat::Int16:	ImGui_ExtractPositions(cmdList, drawGroupOut, encoder, reinterpret_cast<uint16_t*>(pPositions)); break;
+	case eVertPosFormat::Float:	ImGui_ExtractPositions(cmdList, drawGroupOut, encoder, reinterpret_cast<float*>(pPositions)); break;
 	}
 }
 
 //=================================================================================================
-// 
+// Output the primitives stream : [glyph count][solid UV][glyphs][segments]
 //=================================================================================================
-inline void ImGui_ExtractVertices(const ImDrawList& cmdList, ImguiDrawGroup& drawGroupOut, ComDataType*& pDataOutput)
+inline void ImGui_ExtractPrimitives(ImguiDrawGroup& drawGroupOut, ComDataType*& pDataOutput, const GeometryEncoder& encoder)
 {
-	drawGroupOut.mVerticeCount		= static_cast<uint32_t>(cmdList.VtxBuffer.size());
-	drawGroupOut.mReferenceCoord[0] = drawGroupOut.mVerticeCount > 0 ? cmdList.VtxBuffer[0].pos.x : 0.f;
-	drawGroupOut.mReferenceCoord[1] = drawGroupOut.mVerticeCount > 0 ? cmdList.VtxBuffer[0].pos.y : 0.f;
-	SetAndIncreaseDataPointer(drawGroupOut.mpVertices, drawGroupOut.mVerticeCount*sizeof(ImguiVert), pDataOutput);
-	ImguiVert* pVertices		= drawGroupOut.mpVertices.Get();
-	for(int i(0); i<static_cast<int>(drawGroupOut.mVerticeCount); ++i)
+	uint8_t header[10+sizeof(encoder.mSolidUV)];
+	uint8_t* pHeader					= header;
+	WriteVarint(pHeader, static_cast<uint64_t>(encoder.mGlyphs.size()));
+	memcpy(pHeader, encoder.mSolidUV, sizeof(encoder.mSolidUV));
+	pHeader								+= sizeof(encoder.mSolidUV);
+	const bool hasQuads					= drawGroupOut.mQuadCount > 0;
+	const size_t headerSize				= hasQuads ? static_cast<size_t>(pHeader - header) : 0;
+	const size_t glyphsSize				= static_cast<size_t>(encoder.mGlyphs.size()) * sizeof(QuadGlyph);
+	const size_t segmentsSize			= static_cast<size_t>(encoder.mSegments.size());
+	drawGroupOut.mPrimitiveByteSize		= static_cast<uint32_t>(headerSize + glyphsSize + segmentsSize);
+	SetAndIncreaseDataPointer(drawGroupOut.mpPrimitives, drawGroupOut.mPrimitiveByteSize, pDataOutput);
+	if( hasQuads )
+	{
+		uint8_t* pOutput				= drawGroupOut.mpPrimitives.Get();
+		memcpy(pOutput, header, headerSize);					pOutput += headerSize;
+		memcpy(pOutput, encoder.mGlyphs.Data, glyphsSize);		pOutput += glyphsSize;
+		memcpy(pOutput, encoder.mSegments.Data, segmentsSize);
+	}
+}
+
+//=================================================================================================
+// Expand the vertices/indices of a DrawGroup to Dear ImGui format
+// Returns false when the data is invalid
+//=================================================================================================
+struct VertexArrays
+{
+	const uint8_t*	mpColors		= nullptr;	// uint32 colors or uint8/uint16 palette indices
+	const uint32_t*	mpPalette		= nullptr;
+	uint32_t		mPaletteCount	= 0;
+	const uint16_t*	mpUVs			= nullptr;
+	const uint8_t*	mpPositions		= nullptr;
+};
+
+template <typename TIndexType>
+inline bool DecodePaletteColors(const VertexArrays& arrays, const TIndexType* pIndices, uint32_t count, ImDrawVert* pVerticesOut)
+{
+	for(uint32_t i(0); i < count; ++i){
+		if( pIndices[i] >= arrays.mPaletteCount ){
+			return false;
+		}
+		pVerticesOut[i].col = arrays.mpPalette[pIndices[i]];
+	}
+	return true;
+}
+
+#if NETIMGUI_DECODE_SSE2
+// Load the positions of 4 vertices, as 2 vectors of (x,y,x,y)
+inline void DecodeLoadPositions(const uint8_t* pPositions, __m128& pos01Out, __m128& pos23Out)
+{
+	const __m128i positions	= _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pPositions)), _mm_setzero_si128());
+	pos01Out				= _mm_cvtepi32_ps(_mm_unpacklo_epi16(positions, _mm_setzero_si128()));
+	pos23Out				= _mm_cvtepi32_ps(_mm_unpackhi_epi16(positions, _mm_setzero_si128()));
+}
+
+inline void DecodeLoadPositions(const uint16_t* pPositions, __m128& pos01Out, __m128& pos23Out)
+{
+	const __m128i positions	= _mm_loadu_si128(reinterpret_cast<const __m128i*>(pPositions));
+	pos01Out				= _mm_cvtepi32_ps(_mm_unpacklo_epi16(positions, _mm_setzero_si128()));
+	pos23Out				= _mm_cvtepi32_ps(_mm_unpackhi_epi16(positions, _mm_setzero_si128()));
+}
+
+inline void DecodeLoadPositions(const float* pPositions, __m128& pos01Out, __m128& pos23Out)
+{
+	pos01Out				= _mm_loadu_ps(&pPositions[0]);
+	pos23Out				= _mm_loadu_ps(&pPositions[4]);
+}
+#endif
+
+template <typename TPosType>
+inline void DecodePositionsUVs(const ImguiDrawGroup& drawGroup, const TPosType* pPositions, const uint16_t* pUVs, uint32_t count, ImDrawVert* pVerticesOut)
+{
+	const float posScaleInv = 1.f / drawGroup.mPosScale;
+	uint32_t i(0);
+#if NETIMGUI_DECODE_SSE2
+	// Vertex position and UV are contiguous, written together with one 16 bytes store
+	static_assert(offsetof(ImDrawVert, pos) == 0 && offsetof(ImDrawVert, uv) == 8, "Unexpected ImDrawVert layout");
+	constexpr float kUVRangeMin	= static_cast<float>(ImguiDrawGroup::kUvRange_Min);
+	constexpr float kUVRangeMax	= static_cast<float>(ImguiDrawGroup::kUvRange_Max);
+	const __m128 kPosScale		= _mm_set1_ps(posScaleInv);
+	const __m128 kPosRef		= _mm_setr_ps(drawGroup.mReferenceCoord[0], drawGroup.mReferenceCoord[1], drawGroup.mReferenceCoord[0], drawGroup.mReferenceCoord[1]);
+	const __m128 kUVRange		= _mm_set1_ps(kUVRangeMax - kUVRangeMin);
+	const __m128 kUVMax			= _mm_set1_ps(static_cast<float>(0xFFFF));
+	const __m128 kUVMin			= _mm_set1_ps(kUVRangeMin);
+	for(; i + 4 <= count; i += 4)
+	{
+		__m128 pos01, pos23;
+		DecodeLoadPositions(&pPositions[i*2], pos01, pos23);
+		pos01				= _mm_add_ps(_mm_mul_ps(pos01, kPosScale), kPosRef);
+		pos23				= _mm_add_ps(_mm_mul_ps(pos23, kPosScale), kPosRef);
+		const __m128i uvs	= _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pUVs[i*2]));
+		const __m128 uv01	= _mm_add_ps(_mm_div_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(uvs, _mm_setzero_si128())), kUVRange), kUVMax), kUVMin);
+		const __m128 uv23	= _mm_add_ps(_mm_div_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(uvs, _mm_setzero_si128())), kUVRange), kUVMax), kUVMin);
+		_mm_storeu_ps(&pVerticesOut[i+0].pos.x, _mm_movelh_ps(pos01, uv01));
+		_mm_storeu_ps(&pVerticesOut[i+1].pos.x, _mm_movehl_ps(uv01, pos01));
+		_mm_storeu_ps(&pVerticesOut[i+2].pos.x, _mm_movelh_ps(pos23, uv23));
+		_mm_storeu_ps(&pVerticesOut[i+3].pos.x, _mm_movehl_ps(uv23, pos23));
+	}
+#endif
+	for(; i < count; ++i){
+		pVerticesOut[i].pos.x	= static_cast<float>(pPositions[i*2+0]) * posScaleInv + drawGroup.mReferenceCoord[0];
+		pVerticesOut[i].pos.y	= static_cast<float>(pPositions[i*2+1]) * posScaleInv + drawGroup.mReferenceCoord[1];
+		pVerticesOut[i].uv.x	= DecodeUV(pUVs[i*2+0]);
+		pVerticesOut[i].uv.y	= DecodeUV(pUVs[i*2+1]);
+	}
+}
+
+// Decode 'count' vertices of the regular arrays, starting at 'start'
+inline bool DecodeVertices(const ImguiDrawGroup& drawGroup, const VertexArrays& arrays, uint32_t start, uint32_t count, ImDrawVert* pVerticesOut)
+{
+	switch( drawGroup.mColorFormat )
 	{
-		const auto& Vtx			= cmdList.VtxBuffer[i];
-		pVertices[i].mColor		= Vtx.col;
-		pVertices[i].mUV[0]		= static_cast<uint16_t>((Vtx.uv.x	- static_cast<float>(ImguiVert::kUvRange_Min) + 0.5f/65535.f) * 0xFFFF / (ImguiVert::kUvRange_Max - ImguiVert::kUvRange_Min));
-		pVertices[i].mUV[1]		= static_cast<uint16_t>((Vtx.uv.y	- static_cast<float>(ImguiVert::kUvRange_Min) + 0.5f/65535.f) * 0xFFFF / (ImguiVert::kUvRange_Max - ImguiVert::kUvRange_Min));
-		pVertices[i].mPos[0]	= static_cast<uint16_t>((Vtx.pos.x	- drawGroupOut.mReferenceCoord[0] - static_cast<float>(ImguiVert::kPosRange_Min)) * 0xFFFF / (ImguiVert::kPosRange_Max - ImguiVert::kPosRange_Min));
-		pVertices[i].mPos[1]	= static_cast<uint16_t>((Vtx.pos.y	- drawGroupOut.mReferenceCoord[1] - static_cast<float>(ImguiVert::kPosRange_Min)) * 0xFFFF / (ImguiVert::kPosRange_Max - ImguiVert::kPosRange_Min));
+	case eVertColorFormat::Direct:
+		for(uint32_t i(0); i < count; ++i){
+			pVerticesOut[i].col = reinterpret_cast<const uint32_t*>(arrays.mpColors)[start+i];
+		}
+		break;
+	case eVertColorFormat::Palette8:
+		if( !DecodePaletteColors(arrays, arrays.mpColors + start, count, pVerticesOut) ){
+			return false;
+		}
+		break;
+	case eVertColorFormat::Palette16:
+		if( !DecodePaletteColors(arrays, reinterpret_cast<const uint16_t*>(arrays.mpColors) + start, count, pVerticesOut) ){
+			return false;
+		}
+		break;
 	}
+
+	const uint16_t* pUVs = arrays.mpUVs + start*2;
+	switch( drawGroup.mPosFormat )
+	{
+	case eVertPosFormat::Int8:	DecodePositionsUVs(drawGroup, reinterpret_cast<const uint8_t*>(arrays.mpPositions) + start*2, pUVs, count, pVerticesOut); break;
+	case eVertPosFormat::Int16:	DecodePositionsUVs(drawGroup, reinterpret_cast<const uint16_t*>(arrays.mpPositions) + start*2, pUVs, count, pVerticesOut); break;
+	case eVertPosFormat::Float:	DecodePositionsUVs(drawGroup, reinterpret_cast<const float*>(arrays.mpPositions) + start*2, pUVs, count, pVerticesOut); break;
+	}
+	return true;
+}
+
+// Decode 'count' indices of the regular array, starting at 'start'
+inline void DecodeIndices(const ImguiDrawGroup& drawGroup, uint32_t start, uint32_t count, ImDrawIdx* pIndicesOut)
+{
+	if( drawGroup.mBytePerIndex == sizeof(ImDrawIdx) ){
+		memcpy(pIndicesOut, drawGroup.mpIndices.Get() + start*sizeof(ImDrawIdx), count*sizeof(ImDrawIdx));
+	}
+	else if( drawGroup.mBytePerIndex == 2 ){
+		const uint16_t* pIndices = reinterpret_cast<const uint16_t*>(drawGroup.mpIndices.Get()) + start;
+		for(uint32_t i(0); i < count; ++i)
+			pIndicesOut[i] = static_cast<ImDrawIdx>(pIndices[i]);
+	}
+	else{
+		const uint32_t* pIndices = reinterpret_cast<const uint32_t*>(drawGroup.mpIndices.Get()) + start;
+		for(uint32_t i(0); i < count; ++i)
+			pIndicesOut[i] = static_cast<ImDrawIdx>(pIndices[i]);
+	}
+}
+
+bool DecodeDrawGroupGeometry(const ImguiDrawGroup& drawGroup, ImDrawVert* pVerticesOut, ImDrawIdx* pIndicesOut)
+{
+	if( drawGroup.mPosFormat > eVertPosFormat::Float || drawGroup.mColorFormat > eVertColorFormat::Palette16 || !(drawGroup.mPosScale > 0.f) || (drawGroup.mBytePerIndex != 2 && drawGroup.mBytePerIndex != 4) ||
+		static_cast<uint64_t>(drawGroup.mQuadCount)*4 > drawGroup.mVerticeCount || static_cast<uint64_t>(drawGroup.mQuadCount)*6 > drawGroup.mIndiceCount ){
+		return false;
+	}
+	const uint32_t vtxArrayCount = drawGroup.mVerticeCount - drawGroup.mQuadCount*4;
+	const uint32_t idxArrayCount = drawGroup.mIndiceCount - drawGroup.mQuadCount*6;
+
+	// Find the vertices arrays, palette count being saved at the end
+	VertexArrays arrays;
+	const uint8_t* pVertices = drawGroup.mpVertices.Get();
+	if( drawGroup.mColorFormat != eVertColorFormat::Direct ){
+		if( drawGroup.mVertexByteSize < sizeof(uint32_t) ){
+			return false;
+		}
+		memcpy(&arrays.mPaletteCount, pVertices + drawGroup.mVertexByteSize - sizeof(uint32_t), sizeof(uint32_t));
+	}
+	const VertexArraysLayout layout(drawGroup.mPosFormat, drawGroup.mColorFormat, vtxArrayCount, arrays.mPaletteCount);
+	if( layout.mByteSize != drawGroup.mVertexByteSize ){
+		return false;
+	}
+	arrays.mpColors		= pVertices;
+	arrays.mpPalette	= reinterpret_cast<const uint32_t*>(pVertices + layout.mPaletteOffset);
+	arrays.mpUVs		= reinterpret_cast<const uint16_t*>(pVertices + layout.mUVsOffset);
+	arrays.mpPositions	= pVertices + layout.mPositionsOffset;
+
+	// No primitives, only regular vertices/indices
+	if( drawGroup.mQuadCount == 0 ){
+		DecodeIndices(drawGroup, 0, idxArrayCount, pIndicesOut);
+		return DecodeVertices(drawGroup, arrays, 0, vtxArrayCount, pVerticesOut) && drawGroup.mPrimitiveByteSize == 0;
+	}
+
+	const uint8_t* pInput		= drawGroup.mpPrimitives.Get();
+	const uint8_t* pInputEnd	= pInput + drawGroup.mPrimitiveByteSize;
+	uint64_t glyphCount(0);
+	uint16_t solidUV[2];
+	if( !ReadVarint(pInput, pInputEnd, glyphCount) || pInputEnd - pInput < static_cast<ptrdiff_t>(sizeof(solidUV)) ){
+		return false;
+	}
+	memcpy(solidUV, pInput, sizeof(solidUV));
+	pInput						+= sizeof(solidUV);
+	if( glyphCount > static_cast<uint64_t>(pInputEnd - pInput) / sizeof(QuadGlyph) ){
+		return false;
+	}
+	const uint8_t* pGlyphs		= pInput;
+	pInput						+= glyphCount * sizeof(QuadGlyph);
+
+	const float posScaleInv		= 1.f / drawGroup.mPosScale;
+	uint32_t vtxArrayIdx(0), idxArrayIdx(0), vtxIdx(0), idxIdx(0), quadIdx(0);
+	int64_t quadPrevPos[2]		= {};
+	int64_t posSize[2]			= {};
+	uint32_t quadColor			= 0;
+	while( pInput < pInputEnd )
+	{
+		// Regular vertices/indices
+		uint64_t vtxCount(0), idxCount(0), quadCount(0), quadVtxOffset(0);
+		if( !ReadVarint(pInput, pInputEnd, vtxCount) || !ReadVarint(pInput, pInputEnd, idxCount) || !ReadVarint(pInput, pInputEnd, quadCount) ||
+			(quadCount > 0 && !ReadVarint(pInput, pInputEnd, quadVtxOffset)) ||
+			vtxCount > vtxArrayCount - vtxArrayIdx || idxCount > idxArrayCount - idxArrayIdx || quadCount > drawGroup.mQuadCount - quadIdx ){
+			return false;
+		}
+		if( !DecodeVertices(drawGroup, arrays, vtxArrayIdx, static_cast<uint32_t>(vtxCount), &pVerticesOut[vtxIdx]) ){
+			return false;
+		}
+		DecodeIndices(drawGroup, idxArrayIdx, static_cast<uint32_t>(idxCount), &pIndicesOut[idxIdx]);
+		vtxArrayIdx += static_cast<uint32_t>(vtxCount);		vtxIdx += static_cast<uint32_t>(vtxCount);
+		idxArrayIdx += static_cast<uint32_t>(idxCount);		idxIdx += static_cast<uint32_t>(idxCount);
+
+		// Quads, rebuilt from the glyph table or solid rectangle size
+		for(uint64_t i(0); i < quadCount; ++i, ++quadIdx, vtxIdx += 4, idxIdx += 6)
+		{
+			uint64_t glyphToken(0), posDelta[2] = {};
+			QuadGlyph glyph;
+			if( !ReadVarint(pInput, pInputEnd, glyphToken) || !ReadVarint(pInput, pInputEnd, posDelta[0]) || !ReadVarint(pInput, pInputEnd, posDelta[1]) ||
+				(glyphToken >> 1) > glyphCount || quadVtxOffset > vtxIdx ){
+				return false;
+			}
+			if( (glyphToken >> 1) == 0 ){
+				uint64_t size[2] = {};
+				if( !ReadVarint(pInput, pInputEnd, size[0]) || !ReadVarint(pInput, pInputEnd, size[1]) ){
+					return false;
+				}
+				glyph.mUV[0] = glyph.mUV[2] = solidUV[0];
+				glyph.mUV[1] = glyph.mUV[3] = solidUV[1];
+				glyph.mSize[0] = glyph.mSize[1] = 0;
+				posSize[0] = ZigZagDecode(size[0]);
+				posSize[1] = ZigZagDecode(size[1]);
+			}
+			else{
+				memcpy(&glyph, &pGlyphs[((glyphToken >> 1) - 1)*sizeof(QuadGlyph)], sizeof(QuadGlyph));
+				posSize[0] = glyph.mSize[0];
+				posSize[1] = glyph.mSize[1];
+			}
+			if( glyphToken & 1 ){
+				if( pInputEnd - pInput < static_cast<ptrdiff_t>(sizeof(uint32_t)) ){
+					return false;
+				}
+				memcpy(&quadColor, pInput, sizeof(uint32_t));
+				pInput += sizeof(uint32_t);
+			}
+			const int64_t posMin[2]	= {quadPrevPos[0] + ZigZagDecode(posDelta[0]), quadPrevPos[1] + ZigZagDecode(posDelta[1])};
+			const int64_t posMax[2]	= {posMin[0] + posSize[0], posMin[1] + posSize[1]};
+			const float x0			= static_cast<float>(posMin[0]) * posScaleInv + drawGroup.mReferenceCoord[0];
+			const float y0			= static_cast<float>(posMin[1]) * posScaleInv + drawGroup.mReferenceCoord[1];
+			const float x1			= static_cast<float>(posMax[0]) * posScaleInv + drawGroup.mReferenceCoord[0];
+			const float y1			= static_cast<float>(posMax[1]) * posScaleInv + drawGroup.mReferenceCoord[1];
+			const float u0(DecodeUV(glyph.mUV[0])), v0(DecodeUV(glyph.mUV[1])), u1(DecodeUV(glyph.mUV[2])), v1(DecodeUV(glyph.mUV[3]));
+			ImDrawVert* pVtx		= &pVerticesOut[vtxIdx];
+			pVtx[0].pos = ImVec2(x0, y0); pVtx[0].uv = ImVec2(u0, v0); pVtx[0].col = quadColor;
+			pVtx[1].pos = ImVec2(x1, y0); pVtx[1].uv = ImVec2(u1, v0); pVtx[1].col = quadColor;
+			pVtx[2].pos = ImVec2(x1, y1); pVtx[2].uv = ImVec2(u1, v1); pVtx[2].col = quadColor;
+			pVtx[3].pos = ImVec2(x0, y1); pVtx[3].uv = ImVec2(u0, v1); pVtx[3].col = quadColor;
+			const ImDrawIdx index	= static_cast<ImDrawIdx>(vtxIdx - static_cast<uint32_t>(quadVtxOffset));
+			ImDrawIdx* pIdx			= &pIndicesOut[idxIdx];
+			pIdx[0] = index; pIdx[1] = static_cast<ImDrawIdx>(index+1); pIdx[2] = static_cast<ImDrawIdx>(index+2);
+			pIdx[3] = index; pIdx[4] = static_cast<ImDrawIdx>(index+2); pIdx[5] = static_cast<ImDrawIdx>(index+3);
+			quadPrevPos[0]			= posMax[0];
+			quadPrevPos[1]			= posMin[1];
+		}
+	}
+	return vtxArrayIdx == vtxArrayCount && idxArrayIdx == idxArrayCount && quadIdx == drawGroup.mQuadCount;
+}
+
+//=================================================================================================
+// Compact encoding of the DrawGroup draws (see 'ImguiDrawGroup::mpDraws')
+// Textures and clipping rectangles are only stored once per DrawGroup, with draws referencing them
+//=================================================================================================
+struct DrawClipRect
+{
+	int16_t	mRect[4];
+	inline bool operator==(const DrawClipRect& cmp)const { return memcmp(mRect, cmp.mRect, sizeof(mRect)) == 0; }
+};
+
+struct DrawsEncoder
+{
+	static constexpr size_t		kRecordSizeMax	= 5*10;		// 5 varints per draw
+	ImVector<ClientTextureID>	mTextures;
+	ImVector<DrawClipRect>		mClipRects;
+	ImGuiStorage				mClipRectLookup;			// ClipRect hash -> 'mClipRects' index + 1
+	ImVector<uint8_t>			mRecords;
+};
+
+inline int16_t ImGui_QuantizeClip(float value)
+{
+	// Backends convert clip rect to integer scissor, keeping the floored value is enough
+	value = value < -32768.f ? -32768.f : value > 32767.f ? 32767.f : value;
+	return static_cast<int16_t>(ImFloor(value));
 }
 
 //=================================================================================================
 // 
 //=================================================================================================
-inline void ImGui_ExtractDraws(const ImDrawList& cmdList, ImguiDrawGroup& drawGroupOut, ComDataType*& pDataOutput)
+inline void ImGui_ExtractDraws(const ImDrawList& cmdList, ImguiDrawGroup& drawGroupOut, ComDataType*& pDataOutput, DrawsEncoder& encoder)
 {
 	int maxDrawCount			= static_cast<int>(cmdList.CmdBuffer.size());
 	uint32_t drawCount			= 0;
-	ImguiDraw* pOutDraws		= reinterpret_cast<ImguiDraw*>(pDataOutput);
+	uint32_t vtxOffsetPrev		= 0;
+	uint32_t idxOffsetNext		= 0;
+	int textureIdx				= -1;
+	int clipRectIdx				= -1;
+	encoder.mTextures.resize(0);
+	encoder.mClipRects.resize(0);
+	encoder.mClipRectLookup.Clear();
+	encoder.mRecords.resize(maxDrawCount * static_cast<int>(DrawsEncoder::kRecordSizeMax));
+	uint8_t* pRecords			= encoder.mRecords.Data;
 	for(int cmd_i = 0; cmd_i < maxDrawCount; ++cmd_i)
 	{
 		const ImDrawCmd* pCmd = &cmdList.CmdBuffer[cmd_i];
 		if( pCmd->UserCallback == nullptr )
 		{
 		#if IMGUI_VERSION_NUM >= 17100
-			pOutDraws[drawCount].mVtxOffset		= pCmd->VtxOffset;
-			pOutDraws[drawCount].mIdxOffset		= pCmd->IdxOffset;
+			const uint32_t vtxOffset			= pCmd->VtxOffset;
+			const uint32_t idxOffset			= pCmd->IdxOffset;
 		#else
-			pOutDraws[drawCount].mVtxOffset		= 0;
-			pOutDraws[drawCount].mIdxOffset		= 0;
+			const uint32_t vtxOffset			= 0;
+			const uint32_t idxOffset			= idxOffsetNext;
 		#endif
 			
 		#if NETIMGUI_IMGUI_TEXTURES_ENABLED
@@ -109,19 +847,107 @@ inline void ImGui_ExtractDraws(const ImDrawList& cmdList, ImguiDrawGroup& drawGr
 		#else
 			ClientTextureID texClientID			= ConvertToClientTexID(pCmd->TextureId);
 		#endif
-			pOutDraws[drawCount].mClientTexId	= texClientID;
-			pOutDraws[drawCount].mIdxCount		= pCmd->ElemCount;
-			pOutDraws[drawCount].mClipRect[0]	= pCmd->ClipRect.x;
-			pOutDraws[drawCount].mClipRect[1]	= pCmd->ClipRect.y;
-			pOutDraws[drawCount].mClipRect[2]	= pCmd->ClipRect.z;
-			pOutDraws[drawCount].mClipRect[3]	= pCmd->ClipRect.w;
+			// Find the texture in palette (usually only a few different ones, with same one as previous draw)
+			if( textureIdx < 0 || encoder.mTextures[textureIdx] != texClientID ){
+				textureIdx = encoder.mTextures.find_index(texClientID);
+				if( textureIdx < 0 ){
+					textureIdx = encoder.mTextures.size();
+					encoder.mTextures.push_back(texClientID);
+				}
+			}
+
+			// Find the clipping rectangle in palette
+			const DrawClipRect clipRect			= {{ImGui_QuantizeClip(pCmd->ClipRect.x), ImGui_QuantizeClip(pCmd->ClipRect.y), ImGui_QuantizeClip(pCmd->ClipRect.z), ImGui_QuantizeClip(pCmd->ClipRect.w)}};
+			if( clipRectIdx < 0 || !(encoder.mClipRects[clipRectIdx] == clipRect) ){
+				const ImGuiID clipRectHash	= ImHashData(clipRect.mRect, sizeof(clipRect.mRect));
+				clipRectIdx					= encoder.mClipRectLookup.GetInt(clipRectHash) - 1;
+				if( clipRectIdx < 0 || !(encoder.mClipRects[clipRectIdx] == clipRect) ){
+					clipRectIdx = encoder.mClipRects.size();
+					encoder.mClipRects.push_back(clipRect);
+					encoder.mClipRectLookup.SetInt(clipRectHash, clipRectIdx + 1);
+				}
+			}
+
+			// Offsets are usually contiguous with previous draw, only save the difference
+			WriteVarint(pRecords, static_cast<uint64_t>(textureIdx));
+			WriteVarint(pRecords, static_cast<uint64_t>(clipRectIdx));
+			WriteVarint(pRecords, pCmd->ElemCount);
+			WriteVarint(pRecords, ZigZagEncode(static_cast<int64_t>(vtxOffset) - static_cast<int64_t>(vtxOffsetPrev)));
+			WriteVarint(pRecords, ZigZagEncode(static_cast<int64_t>(idxOffset) - static_cast<int64_t>(idxOffsetNext)));
+			vtxOffsetPrev						= vtxOffset;
+			idxOffsetNext						= idxOffset + pCmd->ElemCount;
 			++drawCount;
 		}
 	}
-	drawGroupOut.mDrawCount = drawCount;
-	static_assert(sizeof(ImguiDraw) % ComDataSize == 0, "Need to support zero-ing the pending bytes, when not a size multiple of DataComType");
-	drawGroupOut.mpDraws.SetComDataPtr(pDataOutput);
-	pDataOutput += drawGroupOut.mDrawCount * sizeof(ImguiDraw) / ComDataSize;
+
+	// Output the stream : [texture count][clip count][textures][clips][draws]
+	uint8_t header[2*10];
+	uint8_t* pHeader						= header;
+	WriteVarint(pHeader, static_cast<uint64_t>(encoder.mTextures.size()));
+	WriteVarint(pHeader, static_cast<uint64_t>(encoder.mClipRects.size()));
+	const size_t headerSize					= static_cast<size_t>(pHeader - header);
+	const size_t texturesSize				= static_cast<size_t>(encoder.mTextures.size()) * sizeof(ClientTextureID);
+	const size_t clipRectsSize				= static_cast<size_t>(encoder.mClipRects.size()) * sizeof(DrawClipRect);
+	const size_t recordsSize				= static_cast<size_t>(pRecords - encoder.mRecords.Data);
+	drawGroupOut.mDrawCount					= drawCount;
+	drawGroupOut.mDrawByteSize				= static_cast<uint32_t>(headerSize + texturesSize + clipRectsSize + recordsSize);
+	SetAndIncreaseDataPointer(drawGroupOut.mpDraws, drawGroupOut.mDrawByteSize, pDataOutput);
+	uint8_t* pOutput						= drawGroupOut.mpDraws.Get();
+	memcpy(pOutput, header, headerSize);							pOutput += headerSize;
+	memcpy(pOutput, encoder.mTextures.Data, texturesSize);			pOutput += texturesSize;
+	memcpy(pOutput, encoder.mClipRects.Data, clipRectsSize);		pOutput += clipRectsSize;
+	memcpy(pOutput, encoder.mRecords.Data, recordsSize);
+}
+
+//=================================================================================================
+// Expand the compact draws of a DrawGroup (see 'ImguiDrawGroup::mpDraws')
+// Returns false when the data is invalid
+//=================================================================================================
+bool DecodeDrawGroupDraws(const ImguiDrawGroup& drawGroup, ImguiDraw* pDrawsOut)
+{
+	const uint8_t* pInput		= drawGroup.mpDraws.Get();
+	const uint8_t* pInputEnd	= pInput + drawGroup.mDrawByteSize;
+	uint64_t textureCount(0), clipRectCount(0);
+	if( !ReadVarint(pInput, pInputEnd, textureCount) || !ReadVarint(pInput, pInputEnd, clipRectCount) ||
+		textureCount > static_cast<uint64_t>(pInputEnd - pInput) / sizeof(ClientTextureID) ||
+		clipRectCount > static_cast<uint64_t>(pInputEnd - pInput) / sizeof(DrawClipRect) ||
+		textureCount*sizeof(ClientTextureID) + clipRectCount*sizeof(DrawClipRect) > static_cast<uint64_t>(pInputEnd - pInput) ){
+		return false;
+	}
+	const uint8_t* pTextures	= pInput;
+	const uint8_t* pClipRects	= pTextures + textureCount*sizeof(ClientTextureID);
+	pInput						= pClipRects + clipRectCount*sizeof(DrawClipRect);
+
+	uint32_t vtxOffsetPrev(0), idxOffsetNext(0);
+	for(uint32_t drawIdx(0); drawIdx < drawGroup.mDrawCount; ++drawIdx)
+	{
+		uint64_t textureIdx(0), clipRectIdx(0), idxCount(0), vtxOffsetDelta(0), idxOffsetDelta(0);
+		if( !ReadVarint(pInput, pInputEnd, textureIdx) || !ReadVarint(pInput, pInputEnd, clipRectIdx) || !ReadVarint(pInput, pInputEnd, idxCount) ||
+			!ReadVarint(pInput, pInputEnd, vtxOffsetDelta) || !ReadVarint(pInput, pInputEnd, idxOffsetDelta) ||
+			textureIdx >= textureCount || clipRectIdx >= clipRectCount ){
+			return false;
+		}
+		const int64_t vtxOffset	= static_cast<int64_t>(vtxOffsetPrev) + ZigZagDecode(vtxOffsetDelta);
+		const int64_t idxOffset	= static_cast<int64_t>(idxOffsetNext) + ZigZagDecode(idxOffsetDelta);
+		if( vtxOffset < 0 || vtxOffset > drawGroup.mVerticeCount || idxOffset < 0 || static_cast<uint64_t>(idxOffset) + idxCount > drawGroup.mIndiceCount ){
+			return false;
+		}
+
+		DrawClipRect clipRect;
+		ImguiDraw& drawOut		= pDrawsOut[drawIdx];
+		memcpy(&drawOut.mClientTexId, &pTextures[textureIdx*sizeof(ClientTextureID)], sizeof(ClientTextureID));
+		memcpy(&clipRect, &pClipRects[clipRectIdx*sizeof(DrawClipRect)], sizeof(DrawClipRect));
+		drawOut.mIdxCount		= static_cast<uint32_t>(idxCount);
+		drawOut.mVtxOffset		= static_cast<uint32_t>(vtxOffset);
+		drawOut.mIdxOffset		= static_cast<uint32_t>(idxOffset);
+		drawOut.mClipRect[0]	= static_cast<float>(clipRect.mRect[0]);
+		drawOut.mClipRect[1]	= static_cast<float>(clipRect.mRect[1]);
+		drawOut.mClipRect[2]	= static_cast<float>(clipRect.mRect[2]);
+		drawOut.mClipRect[3]	= static_cast<float>(clipRect.mRect[3]);
+		vtxOffsetPrev			= drawOut.mVtxOffset;
+		idxOffsetNext			= drawOut.mIdxOffset + drawOut.mIdxCount;
+	}
+	return true;
 }
 
 //=================================================================================================
@@ -192,6 +1018,126 @@ void DecompressData(const ComDataType* pDataPrev, size_t dataSizePrev, const Com
 	}	
 }
 
+//=================================================================================================
+// Find the DrawGroups of a frame from their ID (open addressing hash table)
+// Groups with duplicate ID are all inserted, returning the first one found
+//=================================================================================================
+struct DrawGroupLookup
+{
+	explicit DrawGroupLookup(const CmdDrawFrame& drawFrame)
+	: mDrawFrame(drawFrame)
+	{
+		uint32_t tableSize(16);
+		while( tableSize < drawFrame.mDrawGroupCount*2 ){
+			tableSize *= 2;
+		}
+		mTableMask = tableSize - 1;
+		mTable.resize(static_cast<int>(tableSize), ImguiDrawGroup::kInvalidDrawGroup);
+		for(uint32_t i(0); i < drawFrame.mDrawGroupCount; ++i){
+			uint32_t slot = GetSlot(drawFrame.mpDrawGroups[i].mGroupID);
+			while( mTable[static_cast<int>(slot)] != ImguiDrawGroup::kInvalidDrawGroup ){
+				slot = (slot + 1) & mTableMask;
+			}
+			mTable[static_cast<int>(slot)] = i;
+		}
+	}
+
+	uint32_t Find(uint64_t groupID) const
+	{
+		uint32_t slot = GetSlot(groupID);
+		while( mTable[static_cast<int>(slot)] != ImguiDrawGroup::kInvalidDrawGroup ){
+			const uint32_t groupIdx = mTable[static_cast<int>(slot)];
+			if( mDrawFrame.mpDrawGroups[groupIdx].mGroupID == groupID ){
+				return groupIdx;
+			}
+			slot = (slot + 1) & mTableMask;
+		}
+		return ImguiDrawGroup::kInvalidDrawGroup;
+	}
+
+	// Group IDs are already hashed values, only need to fold them
+	inline uint32_t GetSlot(uint64_t groupID) const { return static_cast<uint32_t>(groupID ^ (groupID >> 32)) & mTableMask; }
+
+	const CmdDrawFrame&	mDrawFrame;
+	ImVector<uint32_t>	mTable;
+	uint32_t			mTableMask = 0;
+};
+
+//=================================================================================================
+// Lossy step before delta compression : Vertices of the new frame with a change from the 
+// previous frame under the threshold, get their previous value back. Only applies to the
+// regular vertex arrays of DrawGroups with an identical layout in both frames
+//=================================================================================================
+template <typename TPosType>
+inline void ApplyChangeThresholdPositions(const TPosType* pPositionsPrev, TPosType* pPositionsNew, uint32_t count, float threshold)
+{
+	for(uint32_t i(0); i < count*2; ++i){
+		const float delta = static_cast<float>(pPositionsNew[i]) - static_cast<float>(pPositionsPrev[i]);
+		if( delta < threshold && delta > -threshold ){
+			pPositionsNew[i] = pPositionsPrev[i];
+		}
+	}
+}
+
+inline void ApplyChangeThresholdColors(const uint32_t* pColorsPrev, uint32_t* pColorsNew, uint32_t count, uint8_t threshold)
+{
+	for(uint32_t i(0); i < count; ++i){
+		bool bSmallChange = pColorsNew[i] != pColorsPrev[i];
+		for(uint32_t shift(0); shift < 32 && bSmallChange; shift += 8){
+			const int delta	= static_cast<int>((pColorsNew[i] >> shift) & 0xFF) - static_cast<int>((pColorsPrev[i] >> shift) & 0xFF);
+			bSmallChange	= delta < threshold && delta > -threshold;
+		}
+		if( bSmallChange ){
+			pColorsNew[i] = pColorsPrev[i];
+		}
+	}
+}
+
+void ApplyChangeThreshold(const CmdDrawFrame* pDrawFramePrev, CmdDrawFrame* pDrawFrameNew, float posThreshold, uint8_t colorThreshold)
+{
+	const DrawGroupLookup drawGroupLookupPrev(*pDrawFramePrev);
+	for(uint32_t n = 0; n < pDrawFrameNew->mDrawGroupCount; n++)
+	{
+		ImguiDrawGroup& drawGroup			= pDrawFrameNew->mpDrawGroups[n];
+		const uint32_t groupIdxPrev			= (n < pDrawFramePrev->mDrawGroupCount && drawGroup.mGroupID == pDrawFramePrev->mpDrawGroups[n].mGroupID) ? n : drawGroupLookupPrev.Find(drawGroup.mGroupID);
+		if( groupIdxPrev >= pDrawFramePrev->mDrawGroupCount ){
+			continue;
+		}
+		const ImguiDrawGroup& drawGroupPrev	= pDrawFramePrev->mpDrawGroups[groupIdxPrev];
+		const uint32_t vtxCount				= drawGroup.mVerticeCount - drawGroup.mQuadCount*4;
+		if( drawGroupPrev.mVerticeCount - drawGroupPrev.mQuadCount*4 != vtxCount || drawGroupPrev.mVertexByteSize != drawGroup.mVertexByteSize ||
+			drawGroupPrev.mPosFormat != drawGroup.mPosFormat || drawGroupPrev.mColorFormat != drawGroup.mColorFormat || drawGroupPrev.mPosScale != drawGroup.mPosScale ||
+			drawGroupPrev.mReferenceCoord[0] != drawGroup.mReferenceCoord[0] || drawGroupPrev.mReferenceCoord[1] != drawGroup.mReferenceCoord[1] ){
+			continue;
+		}
+
+		uint32_t paletteCount(0);
+		uint8_t* pVertices					= drawGroup.mpVertices.Get();
+		const uint8_t* pVerticesPrev		= drawGroupPrev.mpVertices.Get();
+		if( drawGroup.mColorFormat != eVertColorFormat::Direct ){
+			memcpy(&paletteCount, pVertices + drawGroup.mVertexByteSize - sizeof(uint32_t), sizeof(uint32_t));
+		}
+		const VertexArraysLayout layout(drawGroup.mPosFormat, drawGroup.mColorFormat, vtxCount, paletteCount);
+		if( posThreshold > 0.f )
+		{
+			const float threshold = posThreshold * drawGroup.mPosScale; // In quantization steps
+			switch( drawGroup.mPosFormat )
+			{
+			case eVertPosFormat::Int8:	ApplyChangeThresholdPositions(reinterpret_cast<const uint8_t*>(pVerticesPrev + layout.mPositionsOffset), reinterpret_cast<uint8_t*>(pVertices + layout.mPositionsOffset), vtxCount, threshold); break;
+			case eVertPosFormat::Int16:	ApplyChangeThresholdPositions(reinterpret_cast<const uint16_t*>(pVerticesPrev + layout.mPositionsOffset), reinterpret_cast<uint16_t*>(pVertices + layout.mPositionsOffset), vtxCount, threshold); break;
+			case eVertPosFormat::Float:	ApplyChangeThresholdPositions(reinterpret_cast<const float*>(pVerticesPrev + layout.mPositionsOffset), reinterpret_cast<float*>(pVertices + layout.mPositionsOffset), vtxCount, threshold); break;
+			}
+		}
+		// With a palette, its entries are compared instead (same layout size means same palette size)
+		if( colorThreshold > 0 )
+		{
+			const bool isPalette	= drawGroup.mColorFormat != eVertColorFormat::Direct;
+			const uint64_t offset	= isPalette ? layout.mPaletteOffset : 0;
+			ApplyChangeThresholdColors(reinterpret_cast<const uint32_t*>(pVerticesPrev + offset), reinterpret_cast<uint32_t*>(pVertices + offset), isPalette ? paletteCount : vtxCount, colorThreshold);
+		}
+	}
+}
+
 //=================================================================================================
 // Take a regular NetImgui DrawFrame command and create a new compressed command
 // It uses a basic delta compression method that works really well with Imgui data
@@ -210,7 +1156,7 @@ CmdDrawFrame* CompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const Cmd
 	//-----------------------------------------------------------------------------------------
 	// Allocate memory for worst case scenario (no compression possible)
 	// New DrawFrame size + 2 'compression block info' per data stream
-	size_t neededDataCount			= DivUp<size_t>(pDrawFrameNew->mSize, ComDataSize) + 6*static_cast<size_t>(pDrawFrameNew->mDrawGroupCount);
+	size_t neededDataCount			= DivUp<size_t>(pDrawFrameNew->mSize, ComDataSize) + 8*static_cast<size_t>(pDrawFrameNew->mDrawGroupCount);
 	CmdDrawFrame* pDrawFramePacked	= netImguiSizedNew<CmdDrawFrame>(neededDataCount*ComDataSize);
 	*pDrawFramePacked				= *pDrawFrameNew;
 	pDrawFramePacked->mCompressed	= true;
@@ -222,6 +1168,7 @@ CmdDrawFrame* CompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const Cmd
 	// Copy draw data (vertices, indices, drawcall info, ...)
 	//-----------------------------------------------------------------------------------------
 	const uint32_t groupCountPrev = pDrawFramePrev->mDrawGroupCount;
+	const DrawGroupLookup drawGroupLookupPrev(*pDrawFramePrev);
 	for(uint32_t n = 0; n < pDrawFramePacked->mDrawGroupCount; n++)
 	{
 		// Look for the same drawgroup in previous frame
@@ -229,37 +1176,41 @@ CmdDrawFrame* CompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const Cmd
 		const ImguiDrawGroup& drawGroupNew	= pDrawFrameNew->mpDrawGroups[n];
 		ImguiDrawGroup& drawGroup			= pDrawFramePacked->mpDrawGroups[n];
 		drawGroup							= drawGroupNew;
-		drawGroup.mDrawGroupIdxPrev			= (n < groupCountPrev && drawGroup.mGroupID == pDrawFramePrev->mpDrawGroups[n].mGroupID) ? n : ImguiDrawGroup::kInvalidDrawGroup;
-		for(uint32_t j(0); j<groupCountPrev && drawGroup.mDrawGroupIdxPrev == ImguiDrawGroup::kInvalidDrawGroup; ++j){
-			drawGroup.mDrawGroupIdxPrev = (drawGroup.mGroupID == pDrawFramePrev->mpDrawGroups[j].mGroupID) ? j : ImguiDrawGroup::kInvalidDrawGroup;
-		}
+		drawGroup.mDrawGroupIdxPrev			= (n < groupCountPrev && drawGroup.mGroupID == pDrawFramePrev->mpDrawGroups[n].mGroupID) ? n : drawGroupLookupPrev.Find(drawGroup.mGroupID);
 
-		// Delta compress the 3 data streams
-		const uint64_t *pVerticePrev(nullptr), *pIndicePrev(nullptr), *pDrawsPrev(nullptr);
-		size_t verticeSizePrev(0), indiceSizePrev(0), drawSizePrev(0);
+		// Delta compress the 4 data streams
+		const uint64_t *pVerticePrev(nullptr), *pIndicePrev(nullptr), *pDrawsPrev(nullptr), *pPrimitivesPrev(nullptr);
+		size_t verticeSizePrev(0), indiceSizePrev(0), drawSizePrev(0), primitiveSizePrev(0);
 		if (drawGroup.mDrawGroupIdxPrev < pDrawFramePrev->mDrawGroupCount) {
 			const ImguiDrawGroup& drawGroupPrev = pDrawFramePrev->mpDrawGroups[drawGroup.mDrawGroupIdxPrev];
 			pVerticePrev						= reinterpret_cast<const uint64_t*>(drawGroupPrev.mpVertices.Get());
 			pIndicePrev							= reinterpret_cast<const uint64_t*>(drawGroupPrev.mpIndices.Get());
 			pDrawsPrev							= reinterpret_cast<const uint64_t*>(drawGroupPrev.mpDraws.Get());
-			verticeSizePrev						= drawGroupPrev.mVerticeCount * sizeof(ImguiVert);
-			indiceSizePrev						= drawGroupPrev.mIndiceCount*static_cast<size_t>(drawGroupPrev.mBytePerIndex);
-			drawSizePrev						= drawGroupPrev.mDrawCount*sizeof(ImguiDraw);
+			pPrimitivesPrev						= reinterpret_cast<const uint64_t*>(drawGroupPrev.mpPrimitives.Get());
+			verticeSizePrev						= drawGroupPrev.mVertexByteSize;
+			indiceSizePrev						= drawGroupPrev.GetIndexByteSize();
+			drawSizePrev						= drawGroupPrev.mDrawByteSize;
+			primitiveSizePrev					= drawGroupPrev.mPrimitiveByteSize;
 		}
 
 		drawGroup.mpIndices.SetComDataPtr(pDataOutput);
 		CompressData(	pIndicePrev,							indiceSizePrev,	
-						drawGroupNew.mpIndices.GetComData(),	drawGroupNew.mIndiceCount*static_cast<size_t>(drawGroupNew.mBytePerIndex),
+						drawGroupNew.mpIndices.GetComData(),	drawGroupNew.GetIndexByteSize(),
 						pDataOutput);
 
 		drawGroup.mpVertices.SetComDataPtr(pDataOutput);
 		CompressData(	pVerticePrev,							verticeSizePrev,
-						drawGroupNew.mpVertices.GetComData(),	drawGroupNew.mVerticeCount * sizeof(ImguiVert),
+						drawGroupNew.mpVertices.GetComData(),	drawGroupNew.mVertexByteSize,
 						pDataOutput);
 
 		drawGroup.mpDraws.SetComDataPtr(pDataOutput);
 		CompressData(	pDrawsPrev,								drawSizePrev,
-						drawGroupNew.mpDraws.GetComData(),		drawGroupNew.mDrawCount*sizeof(ImguiDraw),
+						drawGroupNew.mpDraws.GetComData(),		drawGroupNew.mDrawByteSize,
+						pDataOutput);
+
+		drawGroup.mpPrimitives.SetComDataPtr(pDataOutput);
+		CompressData(	pPrimitivesPrev,						primitiveSizePrev,
+						drawGroupNew.mpPrimitives.GetComData(),	drawGroupNew.mPrimitiveByteSize,
 						pDataOutput);
 	}
 
@@ -288,34 +1239,42 @@ CmdDrawFrame* DecompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const C
 		ImguiDrawGroup& drawGroup			= pDrawFrameNew->mpDrawGroups[n];
 		drawGroup							= drawGroupPack;
 
-		// Uncompress the 3 data streams
+		// Uncompress the 4 data streams
 		const ComDataType* pVerticePrev		= nullptr;
 		const ComDataType* pIndicePrev		= nullptr;
 		const ComDataType* pDrawsPrev		= nullptr;
-		size_t verticeSizePrev(0), indiceSizePrev(0), drawSizePrev(0);
+		const ComDataType* pPrimitivesPrev	= nullptr;
+		size_t verticeSizePrev(0), indiceSizePrev(0), drawSizePrev(0), primitiveSizePrev(0);
 		if (drawGroup.mDrawGroupIdxPrev < pDrawFramePrev->mDrawGroupCount) {
 			const ImguiDrawGroup& drawGroupPrev = pDrawFramePrev->mpDrawGroups[drawGroup.mDrawGroupIdxPrev];
 			pVerticePrev					= reinterpret_cast<const ComDataType*>(drawGroupPrev.mpVertices.Get());
 			pIndicePrev						= reinterpret_cast<const ComDataType*>(drawGroupPrev.mpIndices.Get());
 			pDrawsPrev						= reinterpret_cast<const ComDataType*>(drawGroupPrev.mpDraws.Get());
-			verticeSizePrev					= drawGroupPrev.mVerticeCount * sizeof(ImguiVert);
-			indiceSizePrev					= drawGroupPrev.mIndiceCount*static_cast<size_t>(drawGroupPrev.mBytePerIndex);
-			drawSizePrev					= drawGroupPrev.mDrawCount*sizeof(ImguiDraw);
+			pPrimitivesPrev					= reinterpret_cast<const ComDataType*>(drawGroupPrev.mpPrimitives.Get());
+			verticeSizePrev					= drawGroupPrev.mVertexByteSize;
+			indiceSizePrev					= drawGroupPrev.GetIndexByteSize();
+			drawSizePrev					= drawGroupPrev.mDrawByteSize;
+			primitiveSizePrev				= drawGroupPrev.mPrimitiveByteSize;
 		}
 
 		drawGroup.mpIndices.SetComDataPtr(pDataOutput);
 		DecompressData( pIndicePrev,							indiceSizePrev,
-						drawGroupPack.mpIndices.GetComData(),	drawGroupPack.mIndiceCount*static_cast<size_t>(drawGroupPack.mBytePerIndex),
+						drawGroupPack.mpIndices.GetComData(),	drawGroupPack.GetIndexByteSize(),
 						pDataOutput);
 
 		drawGroup.mpVertices.SetComDataPtr(pDataOutput);
 		DecompressData(	pVerticePrev,							verticeSizePrev,
-						drawGroupPack.mpVertices.GetComData(),	drawGroupPack.mVerticeCount*sizeof(ImguiVert),
+						drawGroupPack.mpVertices.GetComData(),	drawGroupPack.mVertexByteSize,
 						pDataOutput);
 
 		drawGroup.mpDraws.SetComDataPtr(pDataOutput);
 		DecompressData( pDrawsPrev,								drawSizePrev,
-						drawGroupPack.mpDraws.GetComData(),		drawGroupPack.mDrawCount*sizeof(ImguiDraw),
+						drawGroupPack.mpDraws.GetComData(),		drawGroupPack.mDrawByteSize,
+						pDataOutput);
+
+		drawGroup.mpPrimitives.SetComDataPtr(pDataOutput);
+		DecompressData( pPrimitivesPrev,						primitiveSizePrev,
+						drawGroupPack.mpPrimitives.GetComData(),drawGroupPack.mPrimitiveByteSize,
 						pDataOutput);
 	}
 	return pDrawFrameNew;
@@ -326,7 +1285,7 @@ CmdDrawFrame* DecompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const C
 // It involves saving each window draw group vertex/indices/draw buffers 
 // and packing their data a little bit, to reduce the bandwidth usage
 //=================================================================================================
-CmdDrawFrame* ConvertToCmdDrawFrame(const ImDrawData* pDearImguiData, ImGuiMouseCursor mouseCursor)
+CmdDrawFrame* ConvertToCmdDrawFrame(const ImDrawData* pDearImguiData, ImGuiMouseCursor mouseCursor, eVertexPrecision vertexPrecision, const ImDrawList* const* ppDrawListsOverride)
 {
 	//-----------------------------------------------------------------------------------------
 	// Find memory needed for entire DrawFrame Command
@@ -336,11 +1295,12 @@ CmdDrawFrame* ConvertToCmdDrawFrame(const ImDrawData* pDearImguiData, ImGuiMouse
 	neededDataCount			+= DivUp(static_cast<size_t>(pDearImguiData->CmdListsCount) * sizeof(ImguiDrawGroup), ComDataSize);
 	for(int n = 0; n < pDearImguiData->CmdListsCount; n++)
 	{
-		const ImDrawList* pCmdList	= pDearImguiData->CmdLists[n];
+		const ImDrawList* pCmdList	= ppDrawListsOverride && ppDrawListsOverride[n] ? ppDrawListsOverride[n] : pDearImguiData->CmdLists[n];
 		bool is16Bit				= pCmdList->VtxBuffer.size() <= 0xFFFF;
-		neededDataCount				+= DivUp(static_cast<size_t>(pCmdList->VtxBuffer.size()) * sizeof(ImguiVert), ComDataSize);
+		neededDataCount				+= DivUp(static_cast<size_t>(VertexArraysLayout(eVertPosFormat::Float, eVertColorFormat::Direct, static_cast<uint64_t>(pCmdList->VtxBuffer.size()), 0).mByteSize), ComDataSize);
 		neededDataCount				+= DivUp(static_cast<size_t>(pCmdList->IdxBuffer.size()) * (is16Bit ? 2 : 4), ComDataSize);
-		neededDataCount				+= DivUp(static_cast<size_t>(pCmdList->CmdBuffer.size()) * sizeof(ImguiDraw), ComDataSize);
+		neededDataCount				+= DivUp(static_cast<size_t>(pCmdList->CmdBuffer.size()) * (sizeof(ClientTextureID) + sizeof(DrawClipRect) + DrawsEncoder::kRecordSizeMax) + 2*10, ComDataSize);
+		neededDataCount				+= DivUp(static_cast<size_t>(pCmdList->VtxBuffer.size() / 4) * GeometryEncoder::kQuadSizeMax + 5*10, ComDataSize);
 	}
 
 	//-----------------------------------------------------------------------------------------
@@ -359,15 +1319,19 @@ CmdDrawFrame* ConvertToCmdDrawFrame(const ImDrawData* pDearImguiData, ImGuiMouse
 	//-----------------------------------------------------------------------------------------
 	// Copy draw data (vertices, indices, drawcall info, ...)
 	//-----------------------------------------------------------------------------------------
+	DrawsEncoder drawsEncoder;
+	GeometryEncoder geometryEncoder;
 	for(size_t n = 0; n < pDrawFrame->mDrawGroupCount; n++)
 	{
 		ImguiDrawGroup& drawGroup		= pDrawFrame->mpDrawGroups[n];
-		const ImDrawList* pCmdList		= pDearImguiData->CmdLists[static_cast<int>(n)];
+		const ImDrawList* pCmdListOwner	= pDearImguiData->CmdLists[static_cast<int>(n)];
+		const ImDrawList* pCmdList		= ppDrawListsOverride && ppDrawListsOverride[n] ? ppDrawListsOverride[n] : pCmdListOwner; // Content previously sent for throttled windows
 		drawGroup						= ImguiDrawGroup();
-		drawGroup.mGroupID				= PointerCast<uint64_t>(pCmdList->_OwnerName); // Use the name string pointer as a unique ID (seems to remain the same between frame)
-		ImGui_ExtractIndices(*pCmdList,	drawGroup, pDataOutput);
-		ImGui_ExtractVertices(*pCmdList,drawGroup, pDataOutput);
-		ImGui_ExtractDraws(*pCmdList,	drawGroup, pDataOutput);
+		drawGroup.mGroupID				= pCmdListOwner->_OwnerName ? ImHashStr(pCmdListOwner->_OwnerName) : 0; // Same value as the owner window ImGuiID, stable between frames even when window is recreated
+		ImGui_ExtractVertices(*pCmdList,drawGroup, pDataOutput, vertexPrecision, geometryEncoder);
+		ImGui_ExtractIndices(*pCmdList,	drawGroup, pDataOutput, geometryEncoder);
+		ImGui_ExtractDraws(*pCmdList,	drawGroup, pDataOutput, drawsEncoder);
+		ImGui_ExtractPrimitives(		drawGroup, pDataOutput, geometryEncoder);
 		pDrawFrame->mTotalVerticeCount	+= drawGroup.mVerticeCount;
 		pDrawFrame->mTotalIndiceCount	+= drawGroup.mIndiceCount;
 		pDrawFrame->mTotalDrawCount		+= drawGroup.mDrawCount;
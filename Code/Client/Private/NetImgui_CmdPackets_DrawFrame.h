@@ -5,14 +5,11 @@
 namespace NetImgui { namespace Internal
 {
 
-struct ImguiVert
-{
-	//Note: If updating this, increase 'CmdVersion::eVersion'
-	enum Constants{ kUvRange_Min=0, kUvRange_Max=1, kPosRange_Min=-8192, kPosRange_Max=8192};
-	uint16_t	mPos[2];
-	uint16_t	mUV[2];
-	uint32_t	mColor;
-};
+// Storage of the vertices position, picked per DrawGroup
+enum class eVertPosFormat : uint8_t { Int8, Int16, Float };
+
+// Storage of the vertices color, picked per DrawGroup (palette used when smaller)
+enum class eVertColorFormat : uint8_t { Direct, Palette8, Palette16 };
 
 struct ImguiDraw
 {
@@ -25,26 +22,57 @@ struct ImguiDraw
 };
 
 // Each DearImgui window has its own vertex/index buffers with multiple drawcalls
+// The vertices are sent as 3 arrays : [uint32 colors][uint16 x2 UVs in [0,1] range][positions]
+//	Positions are quantized integers relative to 'mReferenceCoord' with 'mPosScale' steps per pixel
+//	(picked from the group bounding box) or floats
+//	Colors can instead be uint8/uint16 indices in a palette : [indices][UVs][positions][uint32 palette][uint32 palette count]
+//	(indices and positions arrays padded to 4 bytes)
+// Quads (text glyphs and solid rectangles) are removed from the vertices/indices arrays and sent in the primitives stream instead
+//	[varint glyph count][uint16 x2 solid UV][glyph table : uint16 x4 UVs, int16 x2 size]
+//	Per segment : [varint vertex count][varint index count][varint quad count][varint quad vertex offset (when quad count > 0)]
+//		Vertex/index counts taken from the regular arrays, followed by the quads records
+//		Per quad : [varint (glyph index + 1, 0 for solid) * 2 + color changed][zigzag varint x offset from previous quad right][zigzag varint y offset from previous quad top]
+//					[zigzag varint x2 size (when solid)][uint32 color (when changed)]
+//	Expanded with the vertices/indices arrays in 'DecodeDrawGroupGeometry'
+// The drawcalls are sent in a compact stream, expanded to 'ImguiDraw' with 'DecodeDrawGroupDraws'
+//	[varint texture count][varint cliprect count][ClientTextureID palette][int16 x4 cliprect palette]
+//	Per draw : [varint texture index][varint cliprect index][varint index count][zigzag varint vertex offset delta][zigzag varint index offset delta]
 struct alignas(8) ImguiDrawGroup
 {
+	//Note: If updating this, increase 'CmdVersion::eVersion'
+	enum Constants{ kUvRange_Min=0, kUvRange_Max=1 };
 	static constexpr uint32_t	kInvalidDrawGroup	= 0xFFFFFFFF;
-	uint64_t					mGroupID			= 0;				// Unique ID to recognize DrawGroup between 2 frames
+	static constexpr float		kPosScaleMin		= 4.f;				// Integer positions have at least 1/4 pixel precision (otherwise saved as float)
+	static constexpr float		kPosScaleMax		= 256.f;			// Integer positions don't need more than 1/256 pixel precision
+	uint64_t					mGroupID			= 0;				// Unique ID to recognize DrawGroup between 2 frames (owner window ImGuiID)
 	uint32_t					mVerticeCount		= 0;
 	uint32_t					mIndiceCount		= 0;
 	uint32_t					mDrawCount			= 0;
 	uint32_t					mDrawGroupIdxPrev	= kInvalidDrawGroup;// Group index in previous DrawFrame (kInvalidDrawGroup when not using delta compression)
 	uint8_t						mBytePerIndex		= 2;				// 2, 4 bytes
-	uint8_t						PADDING[7]			= {};
-	float						mReferenceCoord[2]	= {};				// Reference position for the encoded vertices offsets (1st vertice top/left position)
+	eVertPosFormat				mPosFormat			= eVertPosFormat::Int16;
+	eVertColorFormat			mColorFormat		= eVertColorFormat::Direct;
+	uint8_t						PADDING[1]			= {};
+	uint32_t					mDrawByteSize		= 0;				// Size of the compact draws stream
+	uint32_t					mVertexByteSize		= 0;				// Size of the vertices arrays
+	uint32_t					mQuadCount			= 0;				// Number of quads sent in the primitives stream instead of the vertices/indices arrays
+	uint32_t					mPrimitiveByteSize	= 0;				// Size of the primitives stream
+	float						mPosScale			= 1.f;				// Integer positions steps per pixel
+	float						mReferenceCoord[2]	= {};				// Reference position for the encoded vertices offsets (group bounding box top/left position)
 	OffsetPointer<uint8_t>		mpIndices;
-	OffsetPointer<ImguiVert>	mpVertices;
-	OffsetPointer<ImguiDraw>	mpDraws;
+	OffsetPointer<uint8_t>		mpVertices;
+	OffsetPointer<uint8_t>		mpDraws;							// Compact draws stream (see above)
+	OffsetPointer<uint8_t>		mpPrimitives;						// Primitives stream (see above)
 	inline void					ToPointers();
 	inline void					ToOffsets();
+	inline uint32_t				GetIndexByteSize()const { return mIndiceCount > mQuadCount*6 ? (mIndiceCount - mQuadCount*6) * mBytePerIndex : 0; }
 };
 
-struct CmdDrawFrame*	ConvertToCmdDrawFrame(const ImDrawData* pDearImguiData, ImGuiMouseCursor cursor);
+struct CmdDrawFrame*	ConvertToCmdDrawFrame(const ImDrawData* pDearImguiData, ImGuiMouseCursor cursor, eVertexPrecision vertexPrecision, const ImDrawList* const* ppDrawListsOverride);
+void					ApplyChangeThreshold(const CmdDrawFrame* pDrawFramePrev, CmdDrawFrame* pDrawFrameNew, float posThreshold, uint8_t colorThreshold);
 struct CmdDrawFrame*	CompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const CmdDrawFrame* pDrawFrameNew);
 struct CmdDrawFrame*	DecompressCmdDrawFrame(const CmdDrawFrame* pDrawFramePrev, const CmdDrawFrame* pDrawFramePacked);
+bool					DecodeDrawGroupDraws(const ImguiDrawGroup& drawGroup, ImguiDraw* pDrawsOut);
+bool					DecodeDrawGroupGeometry(const ImguiDrawGroup& drawGroup, ImDrawVert* pVerticesOut, ImDrawIdx* pIndicesOut);
 
 }} // namespace NetImgui::Internal
@@ -0,0 +1,849 @@
+#include "NetImgui_Shared.h"
+
+#if NETIMGUI_ENABLED
+#include "NetImgui_WarningDisable.h"
+#include "NetImgui_CmdPackets.h"
+#include "NetImgui_CmdPackets_Texture.h"
+
+namespace NetImgui { namespace Internal
+{
+
+//=================================================================================================
+// LZ compression
+// Small byte oriented LZ77 compressor, using the same sequence layout as LZ4 blocks.
+// Each sequence is : [Token] [Literal length ext] [Literals] [Offset] [Match length ext]
+//	- Token is 4bits literal count and 4bits (match length - kLZMatchMin)
+//	- Length over 15 continue in the following bytes, adding up until a byte is not 255
+//	- Offset is 2 bytes (little endian) distance back in the output
+//	- Last sequence only contains literals
+// Favors speed over ratio (single hash probe), since it runs on the client com thread
+//=================================================================================================
+static constexpr size_t		kLZMatchMin		= 4;
+static constexpr size_t		kLZOffsetMax	= 0xFFFF;
+static constexpr uint32_t	kLZHashBits		= 12;
+static constexpr uint32_t	kLZHashCount	= 1u << kLZHashBits;
+
+inline uint32_t LZRead32(const uint8_t* pData)
+{
+	uint32_t value;
+	memcpy(&value, pData, sizeof(value));
+	return value;
+}
+
+inline uint64_t LZRead64(const uint8_t* pData)
+{
+	uint64_t value;
+	memcpy(&value, pData, sizeof(value));
+	return value;
+}
+
+inline uint32_t LZHash(uint32_t value)
+{
+	return (value * 2654435761u) >> (32u - kLZHashBits);
+}
+
+inline size_t LZGetSizeMax(size_t srcSize)
+{
+	return srcSize + srcSize/255 + 16;
+}
+
+inline void LZWriteLength(uint8_t*& pOut, size_t length)
+{
+	while( length >= 255 ){
+		*pOut++	= 255;
+		length	-= 255;
+	}
+	*pOut++ = static_cast<uint8_t>(length);
+}
+
+inline bool LZReadLength(const uint8_t* pSrc, size_t srcSize, size_t& srcPos, size_t& lengthInOut)
+{
+	uint8_t value(0);
+	do {
+		if( srcPos >= srcSize ){
+			return false;
+		}
+		value		= pSrc[srcPos++];
+		lengthInOut	+= value;
+	} while( value == 255 );
+	return true;
+}
+
+// Output buffer must be at least 'LZGetSizeMax(srcSize)'
+static size_t LZCompress(const uint8_t* pSrc, size_t srcSize, uint8_t* pDst)
+{
+	uint32_t hashTable[kLZHashCount] = {};
+	uint8_t* pOut		= pDst;
+	size_t srcPos		= 0;
+	size_t anchorPos	= 0;
+	while( srcPos + kLZMatchMin <= srcSize )
+	{
+		const uint32_t sequence	= LZRead32(&pSrc[srcPos]);
+		const uint32_t hash		= LZHash(sequence);
+		const size_t candidate	= hashTable[hash];
+		hashTable[hash]			= static_cast<uint32_t>(srcPos);
+		if( candidate >= srcPos || srcPos - candidate > kLZOffsetMax || LZRead32(&pSrc[candidate]) != sequence ){
+			srcPos += 1 + ((srcPos - anchorPos) >> 6); // Skip faster through data that doesn't compress
+			continue;
+		}
+
+		// Extend the match as far as possible (8 bytes at a time first)
+		size_t matchLen = kLZMatchMin;
+		while( srcPos + matchLen + sizeof(uint64_t) <= srcSize && LZRead64(&pSrc[candidate + matchLen]) == LZRead64(&pSrc[srcPos + matchLen]) ){
+			matchLen += sizeof(uint64_t);
+		}
+		while( srcPos + matchLen < srcSize && pSrc[candidate + matchLen] == pSrc[srcPos + matchLen] ){
+			++matchLen;
+		}
+
+		// Output the sequence
+		const size_t literalLen	= srcPos - anchorPos;
+		const size_t matchExt	= matchLen - kLZMatchMin;
+		*pOut++					= static_cast<uint8_t>(((literalLen < 15 ? literalLen : 15) << 4) | (matchExt < 15 ? matchExt : 15));
+		if( literalLen >= 15 ){
+			LZWriteLength(pOut, literalLen - 15);
+		}
+		memcpy(pOut, &pSrc[anchorPos], literalLen);
+		pOut					+= literalLen;
+		const size_t offset		= srcPos - candidate;
+		*pOut++					= static_cast<uint8_t>(offset & 0xFF);
+		*pOut++					= static_cast<uint8_t>(offset >> 8);
+		if( matchExt >= 15 ){
+			LZWriteLength(pOut, matchExt - 15);
+		}
+		srcPos					+= matchLen;
+		anchorPos				= srcPos;
+	}
+
+	// Output the remaining literals
+	const size_t literalLen	= srcSize - anchorPos;
+	*pOut++					= static_cast<uint8_t>((literalLen < 15 ? literalLen : 15) << 4);
+	if( literalLen >= 15 ){
+		LZWriteLength(pOut, literalLen - 15);
+	}
+	memcpy(pOut, &pSrc[anchorPos], literalLen);
+	pOut += literalLen;
+	return static_cast<size_t>(pOut - pDst);
+}
+
+// Validates every read/write, since data comes from the network
+static bool LZDecompress(const uint8_t* pSrc, size_t srcSize, uint8_t* pDst, size_t dstSize)
+{
+	size_t srcPos(0), dstPos(0);
+	while( srcPos < srcSize )
+	{
+		const uint8_t token	= pSrc[srcPos++];
+		size_t literalLen	= token >> 4;
+		if( literalLen == 15 && !LZReadLength(pSrc, srcSize, srcPos, literalLen) ){
+			return false;
+		}
+		if( literalLen > srcSize - srcPos || literalLen > dstSize - dstPos ){
+			return false;
+		}
+		memcpy(&pDst[dstPos], &pSrc[srcPos], literalLen);
+		srcPos				+= literalLen;
+		dstPos				+= literalLen;
+		if( srcPos == srcSize ){
+			break; // Last sequence
+		}
+
+		if( srcPos + 2 > srcSize ){
+			return false;
+		}
+		const size_t offset	= static_cast<size_t>(pSrc[srcPos]) | (static_cast<size_t>(pSrc[srcPos+1]) << 8);
+		size_t matchLen		= token & 0x0F;
+		srcPos				+= 2;
+		if( matchLen == 15 && !LZReadLength(pSrc, srcSize, srcPos, matchLen) ){
+			return false;
+		}
+		matchLen			+= kLZMatchMin;
+		if( offset == 0 || offset > dstPos || matchLen > dstSize - dstPos ){
+			return false;
+		}
+
+		// Overlapping copy is used to encode repeated patterns, must be copied in order
+		const uint8_t* pMatch = &pDst[dstPos - offset];
+		if( offset >= matchLen ){
+			memcpy(&pDst[dstPos], pMatch, matchLen);
+		}
+		else{
+			for(size_t i(0); i < matchLen; ++i){
+				pDst[dstPos + i] = pMatch[i];
+			}
+		}
+		dstPos += matchLen;
+	}
+	return dstPos == dstSize;
+}
+
+//=================================================================================================
+// Gradient prediction filter (PNG like)
+// Each byte is replaced by its difference with the prediction 'left + up - upleft' of the same
+// channel. Flat areas, repeated lines and linear gradients all turn into 0, which LZ compresses well
+//=================================================================================================
+static void FilterApply(const uint8_t* pSrc, uint8_t* pDst, size_t pitch, uint32_t height, size_t bytePerPixel)
+{
+	for(size_t i(0); i < bytePerPixel && i < pitch; ++i){
+		pDst[i] = pSrc[i];
+	}
+	for(size_t i(bytePerPixel); i < pitch; ++i){
+		pDst[i] = static_cast<uint8_t>(pSrc[i] - pSrc[i-bytePerPixel]);
+	}
+	for(uint32_t y(1); y < height; ++y)
+	{
+		const uint8_t* pUp	= &pSrc[(y-1)*pitch];
+		const uint8_t* pCur	= &pSrc[y*pitch];
+		uint8_t* pOut		= &pDst[y*pitch];
+		for(size_t i(0); i < bytePerPixel && i < pitch; ++i){
+			pOut[i] = static_cast<uint8_t>(pCur[i] - pUp[i]);
+		}
+		for(size_t i(bytePerPixel); i < pitch; ++i){
+			pOut[i] = static_cast<uint8_t>(pCur[i] - (pCur[i-bytePerPixel] + pUp[i] - pUp[i-bytePerPixel]));
+		}
+	}
+}
+
+// Done in place
+static void FilterRevert(uint8_t* pData, size_t pitch, uint32_t height, size_t bytePerPixel)
+{
+	for(size_t i(bytePerPixel); i < pitch; ++i){
+		pData[i] = static_cast<uint8_t>(pData[i] + pData[i-bytePerPixel]);
+	}
+	for(uint32_t y(1); y < height; ++y)
+	{
+		const uint8_t* pUp	= &pData[(y-1)*pitch];
+		uint8_t* pCur		= &pData[y*pitch];
+		for(size_t i(0); i < bytePerPixel && i < pitch; ++i){
+			pCur[i] = static_cast<uint8_t>(pCur[i] + pUp[i]);
+		}
+		for(size_t i(bytePerPixel); i < pitch; ++i){
+			pCur[i] = static_cast<uint8_t>(pCur[i] + pCur[i-bytePerPixel] + pUp[i] - pUp[i-bytePerPixel]);
+		}
+	}
+}
+
+//=================================================================================================
+// Lossy 4x4 block encoding (RGBA8 only)
+// Each block stores the min/max value of every channel as 2 endpoints and a 2 bits index
+// per pixel, selecting one of the 4 colors interpolated between them (BC1 like, with alpha)
+//=================================================================================================
+static constexpr uint32_t kBlockSize	= 4;
+static constexpr uint32_t kBlockBytes	= 4 + 4 + 4;	// Endpoint min, endpoint max, 16x 2bits indices
+
+inline size_t BlockGetSize(uint32_t width, uint32_t height)
+{
+	return static_cast<size_t>(DivUp(width, kBlockSize)) * static_cast<size_t>(DivUp(height, kBlockSize)) * kBlockBytes;
+}
+
+static void BlockEncode(const uint8_t* pPixels, uint32_t width, uint32_t height, uint8_t* pOut)
+{
+	const size_t pitch = static_cast<size_t>(width) * 4;
+	for(uint32_t by(0); by < height; by += kBlockSize)
+	{
+		for(uint32_t bx(0); bx < width; bx += kBlockSize)
+		{
+			// Gather block pixels (repeating last line/column on image edges)
+			uint8_t blockPixels[kBlockSize*kBlockSize][4];
+			uint8_t colorMin[4]	= {255, 255, 255, 255};
+			uint8_t colorMax[4]	= {0, 0, 0, 0};
+			for(uint32_t i(0); i < kBlockSize*kBlockSize; ++i)
+			{
+				const uint32_t x	= (bx + i % kBlockSize) < width  ? (bx + i % kBlockSize) : width - 1;
+				const uint32_t y	= (by + i / kBlockSize) < height ? (by + i / kBlockSize) : height - 1;
+				const uint8_t* pSrc	= &pPixels[y*pitch + x*4];
+				for(uint32_t c(0); c < 4; ++c){
+					blockPixels[i][c]	= pSrc[c];
+					colorMin[c]			= pSrc[c] < colorMin[c] ? pSrc[c] : colorMin[c];
+					colorMax[c]			= pSrc[c] > colorMax[c] ? pSrc[c] : colorMax[c];
+				}
+			}
+
+			// Project each pixel on the min/max axis, to find the closest interpolated color
+			int32_t axis[4]		= {};
+			int32_t axisLenSq	= 0;
+			for(uint32_t c(0); c < 4; ++c){
+				axis[c]			= static_cast<int32_t>(colorMax[c]) - static_cast<int32_t>(colorMin[c]);
+				axisLenSq		+= axis[c] * axis[c];
+			}
+			uint32_t indices(0);
+			for(uint32_t i(0); axisLenSq > 0 && i < kBlockSize*kBlockSize; ++i)
+			{
+				int32_t dot(0);
+				for(uint32_t c(0); c < 4; ++c){
+					dot += (static_cast<int32_t>(blockPixels[i][c]) - static_cast<int32_t>(colorMin[c])) * axis[c];
+				}
+				const int32_t index = (dot * 3 + axisLenSq/2) / axisLenSq;
+				indices				|= static_cast<uint32_t>(index < 3 ? index : 3) << (i*2);
+			}
+			memcpy(&pOut[0], colorMin, 4);
+			memcpy(&pOut[4], colorMax, 4);
+			for(uint32_t b(0); b < 4; ++b){
+				pOut[8+b] = static_cast<uint8_t>(indices >> (b*8));
+			}
+			pOut += kBlockBytes;
+		}
+	}
+}
+
+static void BlockDecode(const uint8_t* pIn, uint32_t width, uint32_t height, uint8_t* pPixels)
+{
+	const size_t pitch = static_cast<size_t>(width) * 4;
+	for(uint32_t by(0); by < height; by += kBlockSize)
+	{
+		for(uint32_t bx(0); bx < width; bx += kBlockSize)
+		{
+			uint8_t palette[4][4];
+			for(uint32_t c(0); c < 4; ++c){
+				const uint32_t colorMin	= pIn[c];
+				const uint32_t colorMax	= pIn[4+c];
+				for(uint32_t k(0); k < 4; ++k){
+					palette[k][c] = static_cast<uint8_t>((colorMin*(3-k) + colorMax*k + 1) / 3);
+				}
+			}
+			const uint32_t indices	= static_cast<uint32_t>(pIn[8]) | (static_cast<uint32_t>(pIn[9]) << 8) | (static_cast<uint32_t>(pIn[10]) << 16) | (static_cast<uint32_t>(pIn[11]) << 24);
+			const uint32_t sizeX	= (width - bx)  < kBlockSize ? (width - bx)  : kBlockSize;
+			const uint32_t sizeY	= (height - by) < kBlockSize ? (height - by) : kBlockSize;
+			for(uint32_t y(0); y < sizeY; ++y){
+				for(uint32_t x(0); x < sizeX; ++x){
+					const uint32_t index = (indices >> ((y*kBlockSize + x)*2)) & 0x03;
+					memcpy(&pPixels[(by+y)*pitch + (bx+x)*4], palette[index], 4);
+				}
+			}
+			pIn += kBlockBytes;
+		}
+	}
+}
+
+//=================================================================================================
+// Inter-frame video encoding (RGBA8 only)
+// Meant for textures refreshed continuously by the user (game viewport, video, ...). The updated
+// area is split in 8x8 blocks, each predicted from the previous texture content (reference)
+//	- Skip		: Identical to the reference at the same position
+//	- Delta		: Difference with the reference at the same position
+//	- Motion	: Difference with the reference at an offset (scrolling, moving objects)
+//	- Intra		: Gradient filtered pixels of the block, when the reference doesn't help
+// Stream is : [VideoHeader] LZ( [Mode of each block] [Motion vectors] [Residual bytes] )
+// Keyframes (no reference) only contain the gradient filtered image, like 'kTexFmtRGBA8_LZ'
+//=================================================================================================
+static constexpr uint32_t	kVideoBlockSize		= 8;
+static constexpr int32_t	kVideoMotionMax		= 127;	// Motion vector stored as 2x int8
+static constexpr uint32_t	kVideoMotionMinSAD	= 2;	// Average difference per channel before searching for motion
+
+enum class eVideoBlock : uint8_t { Skip, Delta, Motion, Intra, Count };
+enum class eVideoFrame : uint8_t { Key, Inter };
+
+struct VideoHeader
+{
+	eVideoFrame	mFrameType	= eVideoFrame::Key;
+	uint8_t		PADDING[3]	= {};
+	uint32_t	mRawSize	= 0;	// Size of the LZ decompressed data
+};
+
+inline size_t VideoGetRawSizeMax(uint32_t width, uint32_t height)
+{
+	const size_t blockCount = static_cast<size_t>(DivUp(width, kVideoBlockSize)) * static_cast<size_t>(DivUp(height, kVideoBlockSize));
+	return blockCount * 3 + static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+}
+
+inline size_t VideoGetSizeMax(uint32_t width, uint32_t height)
+{
+	return sizeof(VideoHeader) + LZGetSizeMax(VideoGetRawSizeMax(width, height));
+}
+
+inline bool VideoBlockEqual(const uint8_t* pCur, size_t curPitch, const uint8_t* pRef, size_t refPitch, uint32_t w, uint32_t h)
+{
+	for(uint32_t y(0); y < h; ++y){
+		if( memcmp(&pCur[y*curPitch], &pRef[y*refPitch], w*4) != 0 ){
+			return false;
+		}
+	}
+	return true;
+}
+
+// Sum of absolute differences, stops early once over 'sadMax'
+inline uint32_t VideoBlockSAD(const uint8_t* pCur, size_t curPitch, const uint8_t* pRef, size_t refPitch, uint32_t w, uint32_t h, uint32_t sadMax)
+{
+	uint32_t sad(0);
+	for(uint32_t y(0); y < h && sad <= sadMax; ++y){
+		const uint8_t* pLineCur = &pCur[y*curPitch];
+		const uint8_t* pLineRef = &pRef[y*refPitch];
+		for(uint32_t i(0); i < w*4; ++i){
+			sad += static_cast<uint32_t>(pLineCur[i] > pLineRef[i] ? pLineCur[i] - pLineRef[i] : pLineRef[i] - pLineCur[i]);
+		}
+	}
+	return sad;
+}
+
+// Intra prediction of a pixel channel, only using the block's own pixels ('left + up - upleft')
+inline uint8_t VideoIntraPredict(const uint8_t* pPixel, size_t pitch, uint32_t x, uint32_t y)
+{
+	if( x > 0 && y > 0 )	return static_cast<uint8_t>(pPixel[-4] + pPixel[-static_cast<ptrdiff_t>(pitch)] - pPixel[-static_cast<ptrdiff_t>(pitch)-4]);
+	if( x > 0 )				return pPixel[-4];
+	if( y > 0 )				return pPixel[-static_cast<ptrdiff_t>(pitch)];
+	return 0;
+}
+
+inline uint32_t VideoBlockIntraCost(const uint8_t* pCur, size_t curPitch, uint32_t w, uint32_t h)
+{
+	uint32_t cost(0);
+	for(uint32_t y(0); y < h; ++y){
+		for(uint32_t i(0); i < w*4; ++i){
+			const uint8_t* pPixel	= &pCur[y*curPitch + i];
+			const int8_t residual	= static_cast<int8_t>(*pPixel - VideoIntraPredict(pPixel, curPitch, i/4, y));
+			cost					+= static_cast<uint32_t>(residual < 0 ? -residual : residual);
+		}
+	}
+	return cost;
+}
+
+static size_t VideoEncode(const uint8_t* pPixels, uint32_t width, uint32_t height, const uint8_t* pReference, uint32_t refWidth, uint32_t refHeight, uint32_t offsetX, uint32_t offsetY, uint8_t* pDataOut)
+{
+	VideoHeader header;
+	const size_t pitch	= static_cast<size_t>(width) * 4;
+	uint8_t* pTemp		= netImguiSizedNew<uint8_t>(VideoGetRawSizeMax(width, height));
+	if( !pReference )
+	{
+		header.mFrameType	= eVideoFrame::Key;
+		header.mRawSize		= static_cast<uint32_t>(pitch * height);
+		FilterApply(pPixels, pTemp, pitch, height, 4);
+	}
+	else
+	{
+		const size_t refPitch		= static_cast<size_t>(refWidth) * 4;
+		const uint32_t blockCountX	= DivUp(width, kVideoBlockSize);
+		const uint32_t blockCount	= blockCountX * DivUp(height, kVideoBlockSize);
+		ImVector<int8_t> motionPrevRow;	// Motion vector of the blocks above, used as search candidates
+		motionPrevRow.resize(static_cast<int>(blockCountX*2), 0);
+		uint8_t* pModes		= pTemp;
+		uint8_t* pMotions	= &pTemp[blockCount];
+		uint8_t* pResiduals	= netImguiSizedNew<uint8_t>(pitch * height);
+		size_t residualSize(0);
+		uint32_t motionCount(0), blockIndex(0);
+		for(uint32_t by(0); by < height; by += kVideoBlockSize)
+		{
+			int8_t motionLeft[2] = {0, 0};
+			for(uint32_t bx(0); bx < width; bx += kVideoBlockSize, ++blockIndex)
+			{
+				const uint32_t w		= (width - bx)  < kVideoBlockSize ? (width - bx)  : kVideoBlockSize;
+				const uint32_t h		= (height - by) < kVideoBlockSize ? (height - by) : kVideoBlockSize;
+				const int32_t refX		= static_cast<int32_t>(offsetX + bx);
+				const int32_t refY		= static_cast<int32_t>(offsetY + by);
+				const uint8_t* pCur		= &pPixels[by*pitch + bx*4];
+				auto GetRef				= [&](int32_t dx, int32_t dy){ return &pReference[static_cast<size_t>(refY+dy)*refPitch + static_cast<size_t>(refX+dx)*4]; };
+				auto IsValidMotion		= [&](int32_t dx, int32_t dy){ return	dx >= -kVideoMotionMax && dx <= kVideoMotionMax && dy >= -kVideoMotionMax && dy <= kVideoMotionMax &&
+																				refX + dx >= 0 && refX + dx + static_cast<int32_t>(w) <= static_cast<int32_t>(refWidth) &&
+																				refY + dy >= 0 && refY + dy + static_cast<int32_t>(h) <= static_cast<int32_t>(refHeight); };
+				eVideoBlock mode		= eVideoBlock::Skip;
+				int32_t bestDx(0), bestDy(0);
+				if( !VideoBlockEqual(pCur, pitch, GetRef(0, 0), refPitch, w, h) )
+				{
+					uint32_t bestSAD = VideoBlockSAD(pCur, pitch, GetRef(0, 0), refPitch, w, h, 0xFFFFFFFFu);
+					auto TestMotion	= [&](int32_t dx, int32_t dy){
+						if( (dx != bestDx || dy != bestDy) && IsValidMotion(dx, dy) ){
+							const uint32_t sad = VideoBlockSAD(pCur, pitch, GetRef(dx, dy), refPitch, w, h, bestSAD);
+							if( sad < bestSAD ){
+								bestSAD = sad; bestDx = dx; bestDy = dy;
+							}
+						}
+					};
+
+					// Motion search, starting with the motion of neighbour blocks then refined with a diamond search
+					if( bestSAD > w * h * 4 * kVideoMotionMinSAD )
+					{
+						TestMotion(motionLeft[0], motionLeft[1]);
+						TestMotion(motionPrevRow[static_cast<int>(bx/kVideoBlockSize*2)], motionPrevRow[static_cast<int>(bx/kVideoBlockSize*2+1)]);
+						for(int32_t step(static_cast<int32_t>(kVideoBlockSize)); step > 0; step /= 2){
+							const int32_t centerX(bestDx), centerY(bestDy);
+							TestMotion(centerX - step, centerY);
+							TestMotion(centerX + step, centerY);
+							TestMotion(centerX, centerY - step);
+							TestMotion(centerX, centerY + step);
+						}
+					}
+					mode = VideoBlockIntraCost(pCur, pitch, w, h) < bestSAD	? eVideoBlock::Intra :
+						   bestDx == 0 && bestDy == 0						? eVideoBlock::Delta : 
+																			  eVideoBlock::Motion;
+				}
+
+				// Output the block
+				pModes[blockIndex] = static_cast<uint8_t>(mode);
+				if( mode != eVideoBlock::Motion ){
+					bestDx = bestDy = 0;
+				}
+				else{
+					pMotions[motionCount*2+0] = static_cast<uint8_t>(static_cast<int8_t>(bestDx));
+					pMotions[motionCount*2+1] = static_cast<uint8_t>(static_cast<int8_t>(bestDy));
+					motionCount++;
+				}
+				for(uint32_t y(0); mode != eVideoBlock::Skip && y < h; ++y){
+					const uint8_t* pLineRef = mode != eVideoBlock::Intra ? GetRef(bestDx, bestDy) + y*refPitch : nullptr;
+					for(uint32_t i(0); i < w*4; ++i){
+						const uint8_t* pPixel = &pCur[y*pitch + i];
+						pResiduals[residualSize++] = static_cast<uint8_t>(*pPixel - (pLineRef ? pLineRef[i] : VideoIntraPredict(pPixel, pitch, i/4, y)));
+					}
+				}
+				motionLeft[0] = motionPrevRow[static_cast<int>(bx/kVideoBlockSize*2)]	= static_cast<int8_t>(bestDx);
+				motionLeft[1] = motionPrevRow[static_cast<int>(bx/kVideoBlockSize*2+1)]	= static_cast<int8_t>(bestDy);
+			}
+		}
+		// Residuals follow the motion vectors actually used
+		memcpy(&pMotions[motionCount*2], pResiduals, residualSize);
+		netImguiDelete(pResiduals);
+		header.mFrameType	= eVideoFrame::Inter;
+		header.mRawSize		= static_cast<uint32_t>(blockCount + motionCount*2 + residualSize);
+	}
+	memcpy(pDataOut, &header, sizeof(header));
+	const size_t encodedSize = sizeof(header) + LZCompress(pTemp, header.mRawSize, &pDataOut[sizeof(header)]);
+	netImguiDelete(pTemp);
+	return encodedSize;
+}
+
+// Validates every read, since data comes from the network
+static bool VideoDecode(const uint8_t* pData, size_t dataSize, uint32_t width, uint32_t height, const uint8_t* pReference, uint32_t refWidth, uint32_t refHeight, uint32_t offsetX, uint32_t offsetY, uint8_t* pPixelsOut)
+{
+	VideoHeader header;
+	if( dataSize < sizeof(header) ){
+		return false;
+	}
+	memcpy(&header, pData, sizeof(header));
+	const size_t pitch = static_cast<size_t>(width) * 4;
+	if( width == 0 || height == 0 || header.mRawSize > VideoGetRawSizeMax(width, height) || 
+		(header.mFrameType == eVideoFrame::Key && header.mRawSize != pitch * height) ||
+		(header.mFrameType == eVideoFrame::Inter && (!pReference || offsetX + width > refWidth || offsetY + height > refHeight)) ||
+		(header.mFrameType != eVideoFrame::Key && header.mFrameType != eVideoFrame::Inter) )
+	{
+		return false;
+	}
+
+	if( header.mFrameType == eVideoFrame::Key )
+	{
+		if( !LZDecompress(&pData[sizeof(header)], dataSize - sizeof(header), pPixelsOut, header.mRawSize) ){
+			return false;
+		}
+		FilterRevert(pPixelsOut, pitch, height, 4);
+		return true;
+	}
+
+	uint8_t* pTemp	= netImguiSizedNew<uint8_t>(header.mRawSize);
+	bool bValid		= LZDecompress(&pData[sizeof(header)], dataSize - sizeof(header), pTemp, header.mRawSize);
+
+	// Find where each section starts, and make sure their sizes match the received data
+	const size_t refPitch		= static_cast<size_t>(refWidth) * 4;
+	const uint32_t blockCountX	= DivUp(width, kVideoBlockSize);
+	const uint32_t blockCount	= blockCountX * DivUp(height, kVideoBlockSize);
+	size_t motionCount(0), residualSize(0);
+	for(uint32_t i(0); bValid && i < blockCount; ++i){
+		const uint32_t w	= (width  - (i % blockCountX) * kVideoBlockSize) < kVideoBlockSize ? (width  - (i % blockCountX) * kVideoBlockSize) : kVideoBlockSize;
+		const uint32_t h	= (height - (i / blockCountX) * kVideoBlockSize) < kVideoBlockSize ? (height - (i / blockCountX) * kVideoBlockSize) : kVideoBlockSize;
+		const auto mode		= static_cast<eVideoBlock>(i < header.mRawSize ? pTemp[i] : 0xFF);
+		bValid				= mode < eVideoBlock::Count;
+		motionCount			+= mode == eVideoBlock::Motion ? 1 : 0;
+		residualSize		+= mode != eVideoBlock::Skip ? static_cast<size_t>(w) * h * 4 : 0;
+	}
+	bValid = bValid && header.mRawSize == blockCount + motionCount*2 + residualSize;
+
+	const uint8_t* pModes		= pTemp;
+	const uint8_t* pMotions		= &pTemp[blockCount];
+	const uint8_t* pResiduals	= &pMotions[motionCount*2];
+	uint32_t blockIndex(0);
+	for(uint32_t by(0); bValid && by < height; by += kVideoBlockSize)
+	{
+		for(uint32_t bx(0); bValid && bx < width; bx += kVideoBlockSize, ++blockIndex)
+		{
+			const uint32_t w	= (width - bx)  < kVideoBlockSize ? (width - bx)  : kVideoBlockSize;
+			const uint32_t h	= (height - by) < kVideoBlockSize ? (height - by) : kVideoBlockSize;
+			const auto mode		= static_cast<eVideoBlock>(pModes[blockIndex]);
+			int32_t dx(0), dy(0);
+			if( mode == eVideoBlock::Motion ){
+				dx		= static_cast<int8_t>(*pMotions++);
+				dy		= static_cast<int8_t>(*pMotions++);
+				bValid	= static_cast<int32_t>(offsetX + bx) + dx >= 0 && static_cast<int32_t>(offsetX + bx + w) + dx <= static_cast<int32_t>(refWidth) &&
+						  static_cast<int32_t>(offsetY + by) + dy >= 0 && static_cast<int32_t>(offsetY + by + h) + dy <= static_cast<int32_t>(refHeight);
+			}
+			const uint8_t* pRef	= &pReference[static_cast<size_t>(static_cast<int32_t>(offsetY + by) + dy)*refPitch + static_cast<size_t>(static_cast<int32_t>(offsetX + bx) + dx)*4];
+			uint8_t* pOut		= &pPixelsOut[by*pitch + bx*4];
+			for(uint32_t y(0); bValid && y < h; ++y)
+			{
+				if( mode == eVideoBlock::Skip ){
+					memcpy(&pOut[y*pitch], &pRef[y*refPitch], w*4);
+				}
+				else if( mode == eVideoBlock::Intra ){
+					for(uint32_t i(0); i < w*4; ++i){
+						uint8_t* pPixel = &pOut[y*pitch + i];
+						*pPixel			= static_cast<uint8_t>(*pResiduals++ + VideoIntraPredict(pPixel, pitch, i/4, y));
+					}
+				}
+				else{
+					for(uint32_t i(0); i < w*4; ++i){
+						pOut[y*pitch + i] = static_cast<uint8_t>(*pResiduals++ + pRef[y*refPitch + i]);
+					}
+				}
+			}
+		}
+	}
+	netImguiDelete(pTemp);
+	return bValid;
+}
+
+//=================================================================================================
+// Texture formats helpers
+//=================================================================================================
+bool IsTextureFormatCompressed(eTexFormat format)
+{
+	return	format == eTexFormat::kTexFmtRGBA8_LZ || format == eTexFormat::kTexFmtA8_LZ ||
+			format == eTexFormat::kTexFmtRGBA8_Block || format == eTexFormat::kTexFmtRGBA8_Video;
+}
+
+eTexFormat GetTextureFormatCompressed(eTexFormat format, eTexCompression compression)
+{
+	if( format == eTexFormat::kTexFmtRGBA8 ){
+		// Video compression only applies to streamed textures (see 'CompressCmdTextureVideo'), others stay lossless
+		return	compression == eTexCompression::kTexCompressionLossless ||
+				compression == eTexCompression::kTexCompressionVideo	? eTexFormat::kTexFmtRGBA8_LZ :
+				compression == eTexCompression::kTexCompressionLossy	? eTexFormat::kTexFmtRGBA8_Block :
+																		  eTexFormat::kTexFmt_Invalid;
+	}
+	// Alpha8 is mostly used by font atlas, never use lossy compression on it
+	if( format == eTexFormat::kTexFmtA8 && compression != eTexCompression::kTexCompressionNone ){
+		return eTexFormat::kTexFmtA8_LZ;
+	}
+	return eTexFormat::kTexFmt_Invalid;
+}
+
+eTexFormat GetTextureFormatUncompressed(eTexFormat format)
+{
+	switch(format)
+	{
+	case eTexFormat::kTexFmtRGBA8_LZ:		return eTexFormat::kTexFmtRGBA8;
+	case eTexFormat::kTexFmtA8_LZ:			return eTexFormat::kTexFmtA8;
+	case eTexFormat::kTexFmtRGBA8_Block:	return eTexFormat::kTexFmtRGBA8;
+	case eTexFormat::kTexFmtRGBA8_Video:	return eTexFormat::kTexFmtRGBA8;
+	default:								return format;
+	}
+}
+
+size_t GetTextureEncodeSizeMax(eTexFormat formatOut, uint32_t width, uint32_t height)
+{
+	if( formatOut == eTexFormat::kTexFmtRGBA8_Block ){
+		return LZGetSizeMax(BlockGetSize(width, height));
+	}
+	if( formatOut == eTexFormat::kTexFmtRGBA8_Video ){
+		return VideoGetSizeMax(width, height);
+	}
+	const eTexFormat formatRaw = GetTextureFormatUncompressed(formatOut);
+	return LZGetSizeMax(GetTexture_BytePerImage(formatRaw, width, height));
+}
+
+//=================================================================================================
+// Encode raw pixels (in the uncompressed format of 'formatOut') into a compressed stream
+//=================================================================================================
+size_t TextureEncode(eTexFormat formatOut, const uint8_t* pPixels, uint32_t width, uint32_t height, uint8_t* pDataOut, size_t dataOutSize)
+{
+	// Video format needs the previous content, see 'CompressCmdTextureVideo'
+	if( !IsTextureFormatCompressed(formatOut) || formatOut == eTexFormat::kTexFmtRGBA8_Video || width == 0 || height == 0 || dataOutSize < GetTextureEncodeSizeMax(formatOut, width, height) ){
+		return 0;
+	}
+
+	const eTexFormat formatRaw	= GetTextureFormatUncompressed(formatOut);
+	const size_t tempSize		= formatOut == eTexFormat::kTexFmtRGBA8_Block ? BlockGetSize(width, height) : GetTexture_BytePerImage(formatRaw, width, height);
+	uint8_t* pTemp				= netImguiSizedNew<uint8_t>(tempSize);
+	if( formatOut == eTexFormat::kTexFmtRGBA8_Block ){
+		BlockEncode(pPixels, width, height, pTemp);
+	}
+	else{
+		FilterApply(pPixels, pTemp, GetTexture_BytePerLine(formatRaw, width), height, GetTexture_BitsPerPixel(formatRaw)/8);
+	}
+	const size_t encodedSize = LZCompress(pTemp, tempSize, pDataOut);
+	netImguiDelete(pTemp);
+	return encodedSize;
+}
+
+//=================================================================================================
+// Decode a compressed stream into raw pixels (in the uncompressed format of 'formatIn')
+//=================================================================================================
+bool TextureDecode(eTexFormat formatIn, const uint8_t* pData, size_t dataSize, uint32_t width, uint32_t height, uint8_t* pPixelsOut)
+{
+	if( !IsTextureFormatCompressed(formatIn) || formatIn == eTexFormat::kTexFmtRGBA8_Video ){
+		return false;
+	}
+
+	const eTexFormat formatRaw = GetTextureFormatUncompressed(formatIn);
+	if( formatIn == eTexFormat::kTexFmtRGBA8_Block )
+	{
+		const size_t blockSize	= BlockGetSize(width, height);
+		uint8_t* pTemp			= netImguiSizedNew<uint8_t>(blockSize);
+		const bool bValid		= LZDecompress(pData, dataSize, pTemp, blockSize);
+		if( bValid ){
+			BlockDecode(pTemp, width, height, pPixelsOut);
+		}
+		netImguiDelete(pTemp);
+		return bValid;
+	}
+
+	if( !LZDecompress(pData, dataSize, pPixelsOut, GetTexture_BytePerImage(formatRaw, width, height)) ){
+		return false;
+	}
+	FilterRevert(pPixelsOut, GetTexture_BytePerLine(formatRaw, width), height, GetTexture_BitsPerPixel(formatRaw)/8);
+	return true;
+}
+
+//=================================================================================================
+// Content hash (xxHash64 like), used by the Server to share identical textures between clients.
+// Processes 4 independent lanes of 8 bytes, to keep up with the network speed
+//=================================================================================================
+static constexpr uint64_t kHashPrime1 = 0x9E3779B185EBCA87ull;
+static constexpr uint64_t kHashPrime2 = 0xC2B2AE3D27D4EB4Full;
+static constexpr uint64_t kHashPrime3 = 0x165667B19E3779F9ull;
+
+inline uint64_t HashRotl(uint64_t value, uint32_t bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t HashRound(uint64_t acc, uint64_t value)
+{
+	return HashRotl(acc + value * kHashPrime2, 31) * kHashPrime1;
+}
+
+static uint64_t HashData(const uint8_t* pData, size_t dataSize, uint64_t seed)
+{
+	uint64_t lanes[4]	= {seed + kHashPrime1 + kHashPrime2, seed + kHashPrime2, seed, seed - kHashPrime1};
+	size_t pos			= 0;
+	for(; pos + 32 <= dataSize; pos += 32){
+		for(uint32_t i(0); i < 4; ++i){
+			lanes[i] = HashRound(lanes[i], LZRead64(&pData[pos + i*8]));
+		}
+	}
+	uint64_t hash		= HashRotl(lanes[0], 1) + HashRotl(lanes[1], 7) + HashRotl(lanes[2], 12) + HashRotl(lanes[3], 18) + dataSize;
+	for(; pos + 8 <= dataSize; pos += 8){
+		hash = HashRotl(hash ^ HashRound(0, LZRead64(&pData[pos])), 27) * kHashPrime1 + kHashPrime3;
+	}
+	for(; pos < dataSize; ++pos){
+		hash = HashRotl(hash ^ (pData[pos] * kHashPrime3), 11) * kHashPrime1;
+	}
+	hash ^= hash >> 33;
+	hash *= kHashPrime2;
+	hash ^= hash >> 29;
+	hash *= kHashPrime3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+uint64_t GetTextureContentHash(const CmdTexture* pCmdTexture)
+{
+	const uint64_t seed		= (static_cast<uint64_t>(pCmdTexture->mWidth) << 32) | (static_cast<uint64_t>(pCmdTexture->mHeight) << 16) | pCmdTexture->mFormat;
+	const size_t dataSize	= pCmdTexture->mSize > sizeof(CmdTexture) ? pCmdTexture->mSize - sizeof(CmdTexture) : 0;
+	const uint64_t hash		= HashData(pCmdTexture->mpTextureData.Get(), dataSize, seed);
+	return hash != 0 ? hash : 1;
+}
+
+//=================================================================================================
+// Create a new texture command with compressed pixel data
+// Only Create/Update commands with RGBA8/A8 content are compressed, and only when it helps
+//=================================================================================================
+CmdTexture* CompressCmdTexture(const CmdTexture* pCmdTexture, eTexCompression compression)
+{
+	const eTexFormat formatRaw		= static_cast<eTexFormat>(pCmdTexture->mFormat);
+	eTexFormat formatCompressed		= GetTextureFormatCompressed(formatRaw, compression);
+	// Dear ImGui textures (font atlas) are updated in place, keep them lossless
+	if( pCmdTexture->mIsDearImGuiManaged && formatCompressed == eTexFormat::kTexFmtRGBA8_Block ){
+		formatCompressed = eTexFormat::kTexFmtRGBA8_LZ;
+	}
+	if( formatCompressed == eTexFormat::kTexFmt_Invalid || pCmdTexture->mStatus == CmdTexture::eType::Destroy ){
+		return nullptr;
+	}
+
+	const size_t rawSize		= GetTexture_BytePerImage(formatRaw, pCmdTexture->mWidth, pCmdTexture->mHeight);
+	const size_t encodeSizeMax	= GetTextureEncodeSizeMax(formatCompressed, pCmdTexture->mWidth, pCmdTexture->mHeight);
+	CmdTexture* pCmdPacked		= netImguiSizedNew<CmdTexture>(sizeof(CmdTexture) + encodeSizeMax);
+	*pCmdPacked					= *pCmdTexture;
+	pCmdPacked->mpNext			= nullptr;
+	pCmdPacked->mFormat			= static_cast<uint8_t>(formatCompressed);
+	pCmdPacked->mpTextureData.SetPtr(reinterpret_cast<uint8_t*>(&pCmdPacked[1]));
+	const size_t encodedSize	= TextureEncode(formatCompressed, pCmdTexture->mpTextureData.Get(), pCmdTexture->mWidth, pCmdTexture->mHeight, pCmdPacked->mpTextureData.Get(), encodeSizeMax);
+	if( encodedSize == 0 || encodedSize >= rawSize ){
+		netImguiDelete(pCmdPacked);
+		return nullptr;
+	}
+	pCmdPacked->mSize			= static_cast<uint32_t>(sizeof(CmdTexture) + encodedSize);
+	return pCmdPacked;
+}
+
+//=================================================================================================
+// Create a new texture command with the original uncompressed pixel data
+//=================================================================================================
+CmdTexture* DecompressCmdTexture(const CmdTexture* pCmdPacked)
+{
+	const eTexFormat formatPacked	= static_cast<eTexFormat>(pCmdPacked->mFormat);
+	const eTexFormat formatRaw		= GetTextureFormatUncompressed(formatPacked);
+	const size_t rawSize			= GetTexture_BytePerImage(formatRaw, pCmdPacked->mWidth, pCmdPacked->mHeight);
+	CmdTexture* pCmdTexture			= netImguiSizedNew<CmdTexture>(sizeof(CmdTexture) + rawSize);
+	*pCmdTexture					= *pCmdPacked;
+	pCmdTexture->mpNext				= nullptr;
+	pCmdTexture->mFormat			= static_cast<uint8_t>(formatRaw);
+	pCmdTexture->mSize				= static_cast<uint32_t>(sizeof(CmdTexture) + rawSize);
+	pCmdTexture->mpTextureData.SetPtr(reinterpret_cast<uint8_t*>(&pCmdTexture[1]));
+	if( pCmdPacked->mSize < sizeof(CmdTexture) ||
+		!TextureDecode(formatPacked, pCmdPacked->mpTextureData.Get(), pCmdPacked->mSize - sizeof(CmdTexture), pCmdPacked->mWidth, pCmdPacked->mHeight, pCmdTexture->mpTextureData.Get()) )
+	{
+		netImguiDelete(pCmdTexture);
+		return nullptr;
+	}
+	return pCmdTexture;
+}
+
+//=================================================================================================
+// Create a new texture command with inter-frame compressed pixel data
+// 'pReference' is the previous content of the entire texture (refWidth x refHeight), the 
+// command being either a Create (keyframe, no reference needed) or an Update of an area
+//=================================================================================================
+CmdTexture* CompressCmdTextureVideo(const CmdTexture* pCmdTexture, const uint8_t* pReference, uint32_t refWidth, uint32_t refHeight)
+{
+	const bool bKeyFrame = pCmdTexture->mStatus == CmdTexture::eType::Create;
+	if( pCmdTexture->mFormat != eTexFormat::kTexFmtRGBA8 || pCmdTexture->mStatus == CmdTexture::eType::Destroy || pCmdTexture->mWidth == 0 || pCmdTexture->mHeight == 0 ||
+		pCmdTexture->mSize < sizeof(CmdTexture) + GetTexture_BytePerImage(eTexFormat::kTexFmtRGBA8, pCmdTexture->mWidth, pCmdTexture->mHeight) ||
+		(!bKeyFrame && (!pReference || pCmdTexture->mOffsetX + pCmdTexture->mWidth > refWidth || pCmdTexture->mOffsetY + pCmdTexture->mHeight > refHeight)) )
+	{
+		return nullptr;
+	}
+
+	const size_t encodeSizeMax	= VideoGetSizeMax(pCmdTexture->mWidth, pCmdTexture->mHeight);
+	CmdTexture* pCmdPacked		= netImguiSizedNew<CmdTexture>(sizeof(CmdTexture) + encodeSizeMax);
+	*pCmdPacked					= *pCmdTexture;
+	pCmdPacked->mpNext			= nullptr;
+	pCmdPacked->mFormat			= static_cast<uint8_t>(eTexFormat::kTexFmtRGBA8_Video);
+	pCmdPacked->mContentHash	= 0;
+	pCmdPacked->mpTextureData.SetPtr(reinterpret_cast<uint8_t*>(&pCmdPacked[1]));
+	const size_t encodedSize	= VideoEncode(pCmdTexture->mpTextureData.Get(), pCmdTexture->mWidth, pCmdTexture->mHeight, bKeyFrame ? nullptr : pReference, refWidth, refHeight, 
+											  pCmdTexture->mOffsetX, pCmdTexture->mOffsetY, pCmdPacked->mpTextureData.Get());
+	pCmdPacked->mSize			= static_cast<uint32_t>(sizeof(CmdTexture) + encodedSize);
+	return pCmdPacked;
+}
+
+//=================================================================================================
+// Create a new texture command with the original uncompressed pixel data, from an inter-frame
+// compressed one. 'pReference' is the previous content of the entire texture (unused by keyframes)
+//=================================================================================================
+CmdTexture* DecompressCmdTextureVideo(const CmdTexture* pCmdPacked, const uint8_t* pReference, uint32_t refWidth, uint32_t refHeight)
+{
+	const size_t rawSize			= GetTexture_BytePerImage(eTexFormat::kTexFmtRGBA8, pCmdPacked->mWidth, pCmdPacked->mHeight);
+	CmdTexture* pCmdTexture			= netImguiSizedNew<CmdTexture>(sizeof(CmdTexture) + rawSize);
+	*pCmdTexture					= *pCmdPacked;
+	pCmdTexture->mpNext				= nullptr;
+	pCmdTexture->mFormat			= static_cast<uint8_t>(eTexFormat::kTexFmtRGBA8);
+	pCmdTexture->mSize				= static_cast<uint32_t>(sizeof(CmdTexture) + rawSize);
+	pCmdTexture->mpTextureData.SetPtr(reinterpret_cast<uint8_t*>(&pCmdTexture[1]));
+	if( pCmdPacked->mFormat != eTexFormat::kTexFmtRGBA8_Video || pCmdPacked->mSize < sizeof(CmdTexture) ||
+		!VideoDecode(pCmdPacked->mpTextureData.Get(), pCmdPacked->mSize - sizeof(CmdTexture), pCmdPacked->mWidth, pCmdPacked->mHeight, 
+					 pReference, refWidth, refHeight, pCmdPacked->mOffsetX, pCmdPacked->mOffsetY, pCmdTexture->mpTextureData.Get()) )
+	{
+		netImguiDelete(pCmdTexture);
+		return nullptr;
+	}
+	return pCmdTexture;
+}
+
+}} // namespace NetImgui::Internal
+
+#include "NetImgui_WarningReenable.h"
+#endif //#if NETIMGUI_ENABLED
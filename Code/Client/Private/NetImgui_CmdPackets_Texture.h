@@ -0,0 +1,38 @@
+#pragma once
+
+#include "NetImgui_Shared.h"
+
+namespace NetImgui { namespace Internal
+{
+
+struct CmdTexture;
+
+//=================================================================================================
+// Texture transport compression
+// Raw RGBA8/A8 pixels are converted to one of the compressed eTexFormat on the Client com thread,
+// and restored to their original format on the Server, before reaching the texture update code.
+//	- kTexFmtRGBA8_LZ, kTexFmtA8_LZ : Lossless. Gradient prediction filter, followed by LZ compression
+//	- kTexFmtRGBA8_Block			: Lossy. 4x4 pixels blocks with 2 RGBA endpoints and 2 bits
+//									  index per pixel (12 bytes per block), followed by LZ compression
+//	- kTexFmtRGBA8_Video			: Lossless. 8x8 pixels blocks predicted from the previous texture
+//									  content (skip, difference, motion, intra), followed by LZ compression
+//Note: If updating the encoded data layout, increase 'CmdVersion::eVersion'
+//=================================================================================================
+bool				IsTextureFormatCompressed(eTexFormat format);
+eTexFormat			GetTextureFormatCompressed(eTexFormat format, eTexCompression compression);	// kTexFmt_Invalid when not supported
+eTexFormat			GetTextureFormatUncompressed(eTexFormat format);
+
+size_t				GetTextureEncodeSizeMax(eTexFormat formatOut, uint32_t width, uint32_t height);
+size_t				TextureEncode(eTexFormat formatOut, const uint8_t* pPixels, uint32_t width, uint32_t height, uint8_t* pDataOut, size_t dataOutSize);	// Returns encoded size (0 on failure)
+bool				TextureDecode(eTexFormat formatIn, const uint8_t* pData, size_t dataSize, uint32_t width, uint32_t height, uint8_t* pPixelsOut);			// Output buffer must hold an uncompressed image
+
+uint64_t			GetTextureContentHash(const CmdTexture* pCmdTexture);	// Identify identical textures (size, format and pixels), never returns 0
+
+struct CmdTexture*	CompressCmdTexture(const CmdTexture* pCmdTexture, eTexCompression compression);	// nullptr when compression not supported or not beneficial
+struct CmdTexture*	DecompressCmdTexture(const CmdTexture* pCmdTexture);							// nullptr when data is invalid
+
+// Inter-frame compression (kTexFmtRGBA8_Video), needs the previous content of the entire texture as reference
+struct CmdTexture*	CompressCmdTextureVideo(const CmdTexture* pCmdTexture, const uint8_t* pReference, uint32_t refWidth, uint32_t refHeight);	// nullptr when not supported
+struct CmdTexture*	DecompressCmdTextureVideo(const CmdTexture* pCmdTexture, const uint8_t* pReference, uint32_t refWidth, uint32_t refHeight);	// nullptr when data is invalid
+
+}} // namespace NetImgui::Internal
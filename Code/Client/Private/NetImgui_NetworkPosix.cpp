@@ -316,11 +316,12 @@ void DataSend(SocketInfo* pClientSocket, NetImgui::Internal::PendingCom& Pending
     }
 
     // Limit send size per call [cite: 281]
-    size_t BytesToSend = BytesRemaining > static_cast<size_t>(pClientSocket->mSendSizeMax) ? static_cast<size_t>(pClientSocket->mSendSizeMax) : BytesRemaining;
+    size_t BytesToSend(0);
+    const uint8_t* pDataToSend = PendingComSend.GetSendData(static_cast<size_t>(pClientSocket->mSendSizeMax), BytesToSend);
 
     // Send data to remote connection (non-blocking)
     ssize_t resultSent = send(pClientSocket->mSocket,
-                              &reinterpret_cast<const uint8_t*>(PendingComSend.pCommand)[PendingComSend.SizeCurrent],
+                              pDataToSend,
                               BytesToSend,
                               MSG_NOSIGNAL); // Use MSG_NOSIGNAL to prevent SIGPIPE on Linux if connection is broken
 
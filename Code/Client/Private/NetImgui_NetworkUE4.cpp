@@ -204,11 +204,11 @@ void DataSend(SocketInfo* pClientSocket, NetImgui::Internal::PendingCom& Pending
 		return;
 	}
 
-	int32 sizeSent		= 0;
-	int32 sizeToSend	= PendingComSend.pCommand->mSize-PendingComSend.SizeCurrent;
-	sizeToSend			= sizeToSend > pClientSocket->mSendSize ? pClientSocket->mSendSize : sizeToSend;
+	int32 sizeSent				= 0;
+	size_t sizeToSend			= 0;
+	const uint8_t* pDataToSend	= PendingComSend.GetSendData(static_cast<size_t>(pClientSocket->mSendSize), sizeToSend);
 
-	if( pClientSocket->mpSocket->Send(	&reinterpret_cast<uint8*>(PendingComSend.pCommand)[PendingComSend.SizeCurrent],
+	if( pClientSocket->mpSocket->Send(	reinterpret_cast<const uint8*>(pDataToSend),
 										static_cast<int>(sizeToSend),
 										sizeSent) )
 	{
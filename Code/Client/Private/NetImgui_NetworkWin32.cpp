@@ -225,12 +225,12 @@ void DataSend(SocketInfo* pClientSocket, NetImgui::Internal::PendingCom& Pending
 	}
 	
 	// Send data to remote connection
-	int sizeToSend	= static_cast<int>(PendingComSend.pCommand->mSize-PendingComSend.SizeCurrent);
-	sizeToSend		= sizeToSend > pClientSocket->mSendSizeMax ? pClientSocket->mSendSizeMax : sizeToSend;
-	int resultSent 	= send(	pClientSocket->mSocket,
-						  	&reinterpret_cast<char*>(PendingComSend.pCommand)[PendingComSend.SizeCurrent],
-							sizeToSend,
-						  	0);
+	size_t sizeToSend(0);
+	const uint8_t* pDataToSend	= PendingComSend.GetSendData(static_cast<size_t>(pClientSocket->mSendSizeMax), sizeToSend);
+	int resultSent 				= send(	pClientSocket->mSocket,
+						  				reinterpret_cast<const char*>(pDataToSend),
+										static_cast<int>(sizeToSend),
+						  				0);
 
 	if( resultSent != SOCKET_ERROR ){
 		PendingComSend.SizeCurrent += static_cast<size_t>(resultSent);
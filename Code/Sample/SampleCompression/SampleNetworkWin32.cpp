@@ -235,9 +235,11 @@ void DataSend(SocketInfo* pClientSocket, NetImgui::Internal::PendingCom& Pending
 	//=============================================================================
 
 	// Send data to remote connection
+	size_t sizeToSend(0);
+	const uint8_t* pDataToSend = PendingComSend.GetSendData(PendingComSend.pCommand->mSize, sizeToSend);
 	int resultSent = send(	pClientSocket->mSocket, 
-						  	&reinterpret_cast<char*>(PendingComSend.pCommand)[PendingComSend.SizeCurrent],
-						  	static_cast<int>(PendingComSend.pCommand->mSize-PendingComSend.SizeCurrent),
+						  	reinterpret_cast<const char*>(pDataToSend),
+						  	static_cast<int>(sizeToSend),
 						  	0);
 
 	if( resultSent != SOCKET_ERROR ){
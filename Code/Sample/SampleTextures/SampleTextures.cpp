@@ -6,6 +6,8 @@
 
 #include "../Common/Sample.h"
 #include "../Common/TextureResource.h"
+#include <chrono>
+#include <cstdio>
 
 // Enable handling of a Custom Texture Format samples.
 // Only meant as an example, users are free to replace it with their own support
@@ -73,7 +75,7 @@ protected:
 	static constexpr uint32_t kTexCountImgui = static_cast<uint32_t>(EImguiTex::_Count);
 	
 	// List of user managed textures
-	enum class EUserTex{ RGBA32, White, CreateDestroy, DoubleSend, Alpha8,	CustomA, CustomB, Invalid, _Count};	
+	enum class EUserTex{ RGBA32, White, CreateDestroy, DoubleSend, Alpha8,	CustomA, CustomB, Invalid, Benchmark, _Count};	
 	static constexpr uint32_t kTexCountUser	= static_cast<uint32_t>(EUserTex::_Count);
 
 	void 					InitImguiTexture();
@@ -85,6 +87,9 @@ protected:
 	void					DemoImActionPartialUpdate();
 	void 					DemoUserActionCreateDestroy();
 	void 					DemoUserActionDoubleSend();
+	void 					DemoUserActionBenchmark();
+	void					DrawTextureRetention();
+	static void				TextureRefetch(ImTextureID textureId);
 
 	inline TexInfo&			GetTexInfo(EImguiTex Entry);
 	inline TexInfo&			GetTexInfo(EUserTex Entry);
@@ -96,6 +101,7 @@ protected:
 	TexResImgui				mImguiTextures[kTexCountImgui];
 	TexResUser				mUserTextures[kTexCountUser];
 	uint8_t					mActionPartialUpdateCount = 0;
+	char					mBenchmarkResult[256] = {};
 };
 
 //=================================================================================================
@@ -271,6 +277,7 @@ void SampleTextures::Draw()
 								switch(static_cast<EUserTex>(i))
 								{
 									case EUserTex::CreateDestroy: DemoUserActionCreateDestroy(); break;
+									case EUserTex::Benchmark: DemoUserActionBenchmark(); break;
 									default:break;
 								}
 							}
@@ -278,6 +285,10 @@ void SampleTextures::Draw()
 					}
 					ImGui::EndTable();
 				}
+				if( mBenchmarkResult[0] != 0 ){
+					ImGui::TextUnformatted(mBenchmarkResult);
+				}
+				DrawTextureRetention();
 			}
 			ImGui::EndTable();
 		}
@@ -450,6 +461,9 @@ void SampleTextures::InitUserTexture()
 	//-------------------------------------------------------------------------
 	GetTexInfo(EUserTex::Invalid) = TexInfo("Invalid", "Test being able to use an invalid Texture ID on NetImgui, without any issue (would crash on local display)");
 	GetTexInfo(EUserTex::Invalid).mRemoteOnly = true;
+
+	//-------------------------------------------------------------------------
+	GetTexInfo(EUserTex::Benchmark) = TexInfo("Benchmark", "Run", "Measure the cost of adding, updating and removing 10k user textures");
 }
 
 //==================================================================================================
@@ -583,6 +597,75 @@ void SampleTextures::DemoUserActionDoubleSend()
 	NetImgui::SendDataTexture(texInfoDouble.mTextureId, texInfoDouble.mPixels.Data, texInfoDouble.mWidth, texInfoDouble.mHeight, texInfoDouble.mFormat);
 }
 
+//=================================================================================================
+// Measure the cost of NetImgui tracking a large number of user textures (like an asset browser
+// displaying thumbnails). Each texture is added, sent again with a modified content, then removed.
+// Note: When connected, this also sends all these texture commands to the NetImgui Server
+void SampleTextures::DemoUserActionBenchmark()
+//=================================================================================================
+{
+	constexpr uint32_t kTexCount	= 10000;
+	constexpr uint16_t kTexSize		= 4;
+	constexpr uint64_t kTexIDFirst	= 0x7E00000000000000ull; // Range of IDs not used by any other texture
+	uint32_t pixels[kTexSize*kTexSize];
+	memset(pixels, 0xFF, sizeof(pixels));
+
+	auto timeStart = std::chrono::steady_clock::now();
+	for(uint32_t i(0); i<kTexCount; ++i){
+		NetImgui::SendDataTexture(ImTextureID(kTexIDFirst + i*16), pixels, kTexSize, kTexSize, NetImgui::eTexFormat::kTexFmtRGBA8);
+	}
+	auto timeAdd = std::chrono::steady_clock::now();
+
+	pixels[0] = 0xFF0000FF;
+	for(uint32_t i(0); i<kTexCount; ++i){
+		NetImgui::SendDataTexture(ImTextureID(kTexIDFirst + i*16), pixels, kTexSize, kTexSize, NetImgui::eTexFormat::kTexFmtRGBA8);
+	}
+	auto timeUpdate = std::chrono::steady_clock::now();
+
+	for(uint32_t i(0); i<kTexCount; ++i){
+		NetImgui::SendDataTexture(ImTextureID(kTexIDFirst + i*16), nullptr, 0, 0, NetImgui::eTexFormat::kTexFmtRGBA8);
+	}
+	auto timeRemove = std::chrono::steady_clock::now();
+
+	auto elapsedAdd		= std::chrono::duration<double, std::milli>(timeAdd - timeStart).count();
+	auto elapsedUpdate	= std::chrono::duration<double, std::milli>(timeUpdate - timeAdd).count();
+	auto elapsedRemove	= std::chrono::duration<double, std::milli>(timeRemove - timeUpdate).count();
+	snprintf(mBenchmarkResult, sizeof(mBenchmarkResult), "%u textures (%s)\n Add:    %7.2f ms (%.2f us each)\n Update: %7.2f ms (%.2f us each)\n Remove: %7.2f ms (%.2f us each)",
+		kTexCount, NetImgui::IsConnected() ? "connected" : "not connected",
+		elapsedAdd, elapsedAdd * 1000.0 / kTexCount, elapsedUpdate, elapsedUpdate * 1000.0 / kTexCount, elapsedRemove, elapsedRemove * 1000.0 / kTexCount);
+}
+
+//=================================================================================================
+// Let user select how much of the user textures content NetImgui keeps once sent to the Server,
+// and display the resulting memory used by the NetImgui client to track them
+void SampleTextures::DrawTextureRetention()
+//=================================================================================================
+{
+	const char* kRetentionNames[] = {"Copy", "Compressed", "None (refetch)"};
+	int retention = static_cast<int>(NetImgui::GetTextureRetention());
+	ImGui::SetNextItemWidth(150.f);
+	if( ImGui::Combo("Texture Retention", &retention, kRetentionNames, IM_ARRAYSIZE(kRetentionNames)) ){
+		NetImgui::SetTextureRetention(static_cast<NetImgui::eTexRetention>(retention), TextureRefetch);
+	}
+	ImGui::SetItemTooltip("Pixel data kept by NetImgui client after sending a user texture.\nOnly applies to textures sent after this change.");
+	ImGui::Text("NetImgui textures memory: %.1f KB", static_cast<double>(NetImgui::GetTextureMemoryUsage()) / 1024.0);
+}
+
+//=================================================================================================
+// Called by NetImgui when it needs to send again a texture it didn't keep the content of
+// (when using 'kTexRetentionNone'). The pixels are still available in our user textures
+void SampleTextures::TextureRefetch(ImTextureID textureId)
+//=================================================================================================
+{
+	SampleTextures& sample = static_cast<SampleTextures&>(GetSample());
+	for(TexResUser& texRes : sample.mUserTextures)
+	{
+		if( texRes.IsValid() && texRes.mTextureId == textureId ){
+			NetImgui::SendDataTexture(texRes.mTextureId, texRes.mPixels.Data, texRes.mWidth, texRes.mHeight, texRes.mFormat);
+		}
+	}
+}
+
 //=================================================================================================
 // Note: This is a 2nd example of user adding their own texture format.
 //		 This one send the current time, and a sin wave is image generated.
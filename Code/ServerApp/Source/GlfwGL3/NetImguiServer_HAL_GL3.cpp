@@ -114,6 +114,62 @@ void HAL_DestroyRenderTarget(void*& pOutRT, ImTextureData& OutTexture)
 	}
 }
 
+//=================================================================================================
+// HAL IS TEXTURE FORMAT SUPPORTED
+// Alpha8 textures are stored as a single channel texture, with a swizzle returning (1,1,1,red)
+// when sampled. This way, the unmodified backend shader displays them properly
+//=================================================================================================
+bool HAL_IsTextureFormatSupported(ImTextureFormat Format)
+{
+	return Format == ImTextureFormat_RGBA32 || Format == ImTextureFormat_Alpha8;
+}
+
+//=================================================================================================
+// HAL UPDATE TEXTURE
+// Same as 'ImGui_ImplOpenGL3_UpdateTexture', for the Alpha8 format. Texture id is compatible 
+// with the backend, letting it destroy these textures on shutdown
+//=================================================================================================
+void HAL_UpdateTexture(ImTextureData& Texture)
+{
+	IM_ASSERT(Texture.Format == ImTextureFormat_Alpha8);
+	GLint LastTexture(0);
+	glGetIntegerv(GL_TEXTURE_BINDING_2D, &LastTexture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	if( Texture.Status == ImTextureStatus_WantCreate )
+	{
+		const GLint Swizzle[4] = {GL_ONE, GL_ONE, GL_ONE, GL_RED};
+		GLuint TextureId(0);
+		glGenTextures(1, &TextureId);
+		glBindTexture(GL_TEXTURE_2D, TextureId);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, Swizzle);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, Texture.Width, Texture.Height, 0, GL_RED, GL_UNSIGNED_BYTE, Texture.GetPixels());
+		Texture.SetTexID(static_cast<ImTextureID>(TextureId));
+		Texture.SetStatus(ImTextureStatus_OK);
+	}
+	else if( Texture.Status == ImTextureStatus_WantUpdates )
+	{
+		glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(Texture.GetTexID()));
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, Texture.Width);
+		for(const ImTextureRect& Rect : Texture.Updates){
+			glTexSubImage2D(GL_TEXTURE_2D, 0, Rect.x, Rect.y, Rect.w, Rect.h, GL_RED, GL_UNSIGNED_BYTE, Texture.GetPixelsAt(Rect.x, Rect.y));
+		}
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		Texture.SetStatus(ImTextureStatus_OK);
+	}
+	else if( Texture.Status == ImTextureStatus_WantDestroy )
+	{
+		GLuint TextureId = static_cast<GLuint>(Texture.GetTexID());
+		glDeleteTextures(1, &TextureId);
+		Texture.SetTexID(ImTextureID_Invalid);
+		Texture.SetStatus(ImTextureStatus_Destroyed);
+	}
+	glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(LastTexture));
+}
+
 }} //namespace NetImguiServer { namespace App
 
 #endif // HAL_API_PLATFORM_GLFW_GL3
@@ -3,17 +3,38 @@
 #include "NetImguiServer_Network.h"
 #include "NetImguiServer_UI.h"
 #include "NetImguiServer_RemoteClient.h"
+#include "NetImguiServer_Worker.h"
 #include "Fonts/Roboto_Medium.cpp"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define NETIMGUI_SERVER_SSE2 1
+#else
+	#define NETIMGUI_SERVER_SSE2 0
+#endif
 
 namespace NetImguiServer { namespace App
 {
 
-constexpr uint32_t			kClientCountMax		= 32;		//! @sammyfreg todo: support unlimited client count
-ImVector<ServerTexture*>	gServerTextures;				// List of ALL server created textures (used by server and clients)
-ServerTexture*				gServerTextureEmpty	= nullptr;	// Empty texture used when no valid texture found
+struct ServerTextureSlot
+{
+	ServerTexture*	mpTexture	= nullptr;
+	uint32_t		mGeneration	= 1u;	// Incremented when texture is deleted, invalidating its handles (never 0)
+};
+
+constexpr uint32_t				kClientCountReserve	= 32;		// Initial number of client slots allocated (more added as needed)
+ImVector<ServerTextureSlot>		gServerTextures;				// Registry of ALL server created textures (used by server and clients)
+ImVector<uint32_t>				gServerTexturesFree;			// Unused slots of the texture registry
+ImVector<ServerTextureHandle>	gServerTexturesPending;			// Textures with a status change, to process in next 'UpdateServerTextures'
+ImVector<ServerTextureHandle>	gServerTexturesProcessing;		// Textures being processed by 'UpdateServerTextures' (kept to reuse its allocation)
+ServerTexture*					gServerTextureEmpty	= nullptr;	// Empty texture used when no valid texture found
+std::unordered_map<uint64_t, ServerTexture*> gTextureCache;	// Shareable textures, indexed by their content hash
 bool						gLoadedConfigOnce	= false;
+uint64_t					gTextureMemoryUsage	= 0;		// Memory used by textures (GPU and CPU copy), updated once per frame
 
 void UpdateServerTextures();
+void UpdateTextureBudget();
 
 bool Startup(const char* CmdLine)
 {	
@@ -30,7 +51,8 @@ bool Startup(const char* CmdLine)
 	//---------------------------------------------------------------------------------------------
     // Perform application initialization:
 	//---------------------------------------------------------------------------------------------
-	if (RemoteClient::Client::Startup(kClientCountMax) &&
+	if (RemoteClient::Client::Startup(kClientCountReserve) &&
+		NetImguiServer::Worker::Startup() &&
 		NetImguiServer::Network::Startup() &&
 		NetImguiServer::UI::Startup())
 	{
@@ -53,13 +75,15 @@ bool Startup(const char* CmdLine)
 void Shutdown()
 {
 	// Mark all texture resources as wanting deletion
-	for(ServerTexture* texServer : gServerTextures){
+	for(const ServerTextureSlot& texSlot : gServerTextures){
+		ServerTexture* texServer = texSlot.mpTexture;
 		if( texServer && texServer->IsValid() )
 		{
 			if( !texServer->mIsCustom  )
 			{
 				texServer->mTexData.SetStatus(ImTextureStatus_WantDestroy);
 				texServer->mTexData.UnusedFrames = 1;
+				MarkTexturePending(*texServer);
 			}
 			else
 			{
@@ -73,6 +97,8 @@ void Shutdown()
 		}
 	}
 	
+	gTextureCache.clear();
+
 	// Allow Dear ImGui to delete the textures
 	ImGui::NewFrame();
 	ImGui::Render();
@@ -96,13 +122,15 @@ void Shutdown()
 	}
 
 	// Remove deleted textures from clients
-	for(uint32_t i(0); i<RemoteClient::Client::GetCountMax(); ++i)
+	RemoteClient::Client::UpdateActiveList();
+	for(uint32_t i(0); i<RemoteClient::Client::GetActiveCount(); ++i)
 	{
-		RemoteClient::Client& client = RemoteClient::Client::Get(i);
+		RemoteClient::Client& client = RemoteClient::Client::GetActive(i);
 		client.mTextureTable.clear();
 	}
 
 	NetImguiServer::Network::Shutdown();
+	NetImguiServer::Worker::Shutdown();	// After com threads stopped adding jobs
 	NetImguiServer::UI::Shutdown();
 	NetImguiServer::Config::Client::Clear();
 	RemoteClient::Client::Shutdown();
@@ -200,56 +228,162 @@ void DrawClientBackground(RemoteClient::Client& client)
 		ImGui::End();
 		ImGui::Render();
 		client.mBGNeedUpdate = false;
+		client.MarkRenderDirty();
+	}
+}
+
+//=================================================================================================
+// Memory used by a texture on the GPU, and by its CPU copy (when kept)
+static uint64_t GetTextureMemorySize(const ServerTexture& serverTexture)
+//=================================================================================================
+{
+	const ImTextureData& texData	= serverTexture.mTexData;
+	if( serverTexture.mIsCustom || texData.WantDestroyNextFrame || texData.Status == ImTextureStatus_Destroyed ){
+		return 0; // Memory about to be released, or unknown
 	}
+	const uint64_t sizeBytes		= static_cast<uint64_t>(texData.Width) * static_cast<uint64_t>(texData.Height) * static_cast<uint64_t>(texData.BytesPerPixel);
+	return texData.Pixels ? sizeBytes * 2 : sizeBytes;
 }
 
 //=================================================================================================
+// Only textures queued with 'MarkTexturePending' are processed, instead of the entire registry.
+// They stay queued until the backend is done with them (creation, updates, destruction)
 void UpdateServerTextures()
 //=================================================================================================
 {
-	for(int i(gServerTextures.size()-1); i>=0; --i)
+	gServerTexturesProcessing.swap(gServerTexturesPending);
+	gServerTexturesPending.resize(0);
+	for(ServerTextureHandle texHandle : gServerTexturesProcessing)
 	{
-		if( gServerTextures[i] )
+		ServerTexture* pServerTex = GetTexture(texHandle);
+		if( !pServerTex ){
+			continue;
+		}
+
+		ServerTexture& ServerTex	= *pServerTex;
+		ServerTex.mIsPending		= 0u;
+
+		// Textures in a format unknown to Dear ImGui's backend, are handled by platform code
+		if( ServerTex.mTexData.Format != ImTextureFormat_RGBA32 && 
+			ServerTex.mTexData.Status != ImTextureStatus_OK && ServerTex.mTexData.Status != ImTextureStatus_Destroyed )
 		{
-			ServerTexture& ServerTex = *gServerTextures[i];
+			HAL_UpdateTexture(ServerTex.mTexData);
+		}
 
-			// Release un-needed pixel data once it has been processed by backend
-			if( ServerTex.mIsUpdatable == false && 
-				ServerTex.mTexData.Pixels != nullptr && 
-				ServerTex.mTexData.Status == ImTextureStatus_OK )
-			{
-				ServerTex.mTexData.DestroyPixels();
-			}
-			
-			// Backend deleted the texture, remove it from our list
-			else if( ServerTex.mTexData.Status == ImTextureStatus_Destroyed )
-			{
-				ImGui::UnregisterUserTexture(&ServerTex.mTexData);
-				delete gServerTextures[i];
-				gServerTextures[i] = nullptr;
-			}
+		// Forget the update rectangles already uploaded
+		if( ServerTex.mTexData.Status == ImTextureStatus_OK && !ServerTex.mTexData.Updates.empty() )
+		{
+			ServerTex.mTexData.Updates.resize(0);
+		}
+
+		// Release un-needed pixel data once it has been processed by backend
+		if( ServerTex.mIsUpdatable == false && 
+			ServerTex.mTexData.Pixels != nullptr && 
+			ServerTex.mTexData.Status == ImTextureStatus_OK )
+		{
+			ServerTex.mTexData.DestroyPixels();
+		}
+		
+		// Backend deleted the texture, remove it from our registry
+		else if( ServerTex.mTexData.Status == ImTextureStatus_Destroyed )
+		{
+			const uint32_t slotIndex				= static_cast<uint32_t>(ServerTex.mHandle & 0xFFFFFFFFu);
+			ServerTextureSlot& texSlot				= gServerTextures[slotIndex];
+			texSlot.mpTexture						= nullptr;
+			texSlot.mGeneration						= texSlot.mGeneration == 0xFFFFFFFFu ? 1u : texSlot.mGeneration + 1u;
+			gServerTexturesFree.push_back(slotIndex);
+			gTextureMemoryUsage						-= ServerTex.mMemorySize;
+			ImGui::UnregisterUserTexture(&ServerTex.mTexData);
+			delete pServerTex;
+			continue;
+		}
 
-			// Send deletion request to backend
-			else if( ServerTex.mTexData.WantDestroyNextFrame )
+		// Send deletion request to backend
+		else if( ServerTex.mTexData.WantDestroyNextFrame )
+		{
+			const RemoteClient::Client* Client = ServerTex.mOwnerClientIndex >= 0 ? &RemoteClient::Client::Get(ServerTex.mOwnerClientIndex) : nullptr;
+			if( !Client || !Client->mpImguiDrawData || Client->mpImguiDrawData->mFrameIndex > ServerTex.mLastFrameUsed )
 			{
-				const RemoteClient::Client* Client = ServerTex.mOwnerClientIndex >= 0 ? &RemoteClient::Client::Get(ServerTex.mOwnerClientIndex) : nullptr;
-				if( !Client || !Client->mpImguiDrawData || Client->mpImguiDrawData->mFrameIndex > ServerTex.mLastFrameUsed )
+				if(ServerTex.mTexData.UnusedFrames++ > 0)
 				{
-					if(ServerTex.mTexData.UnusedFrames++ > 0)
-					{
-						ServerTex.mTexData.Status = ImTextureStatus_WantDestroy;
-					}
+					ServerTex.mTexData.Status = ImTextureStatus_WantDestroy;
 				}
 			}
 		}
 
-		// Remove release textures (null) from our list
-		if (gServerTextures[i] == nullptr)
+		const uint64_t memorySize	= GetTextureMemorySize(ServerTex);
+		gTextureMemoryUsage			= gTextureMemoryUsage - ServerTex.mMemorySize + memorySize;
+		ServerTex.mMemorySize		= memorySize;
+
+		// Keep processing it until backend is done with it, and nothing left to release
+		if( ServerTex.mTexData.Status != ImTextureStatus_OK || ServerTex.mTexData.WantDestroyNextFrame || 
+			!ServerTex.mTexData.Updates.empty() || (ServerTex.mIsUpdatable == false && ServerTex.mTexData.Pixels != nullptr) )
 		{
-			ImSwap(gServerTextures[i], gServerTextures[gServerTextures.Size-1]);
-			gServerTextures.pop_back();
+			MarkTexturePending(ServerTex);
 		}
 	}
+	gServerTexturesProcessing.resize(0);
+}
+
+//=================================================================================================
+// TEXTURE BUDGET
+// When texture memory is over budget, release the least recently used textures of hidden
+// clients. Their client is asked to send them again once needed (see 'Client::EvictTexture')
+void UpdateTextureBudget()
+//=================================================================================================
+{
+	struct EvictCandidate
+	{
+		RemoteClient::Client*	pClient;
+		uint64_t				clientTexID;
+		uint64_t				lastFrameUsed;
+		uint64_t				memorySize;
+	};
+
+	const uint64_t budgetBytes = static_cast<uint64_t>(NetImguiServer::Config::Server::sTextureBudgetMB) * 1024ull * 1024ull;
+	if( budgetBytes == 0 || gTextureMemoryUsage <= budgetBytes ){
+		return;
+	}
+
+	// Only textures used by a single hidden client can be released
+	std::vector<EvictCandidate> candidates;
+	for(uint32_t i(0); i < RemoteClient::Client::GetActiveCount(); ++i)
+	{
+		RemoteClient::Client& client = RemoteClient::Client::GetActive(i);
+		if( client.mbIsConnected && !client.mbIsReleased && !client.mbIsVisible )
+		{
+			for(const auto& texIt : client.mTextureTable)
+			{
+				const ServerTexture* pTexture = texIt.second;
+				if( pTexture && pTexture->IsValid() && !pTexture->mIsCustom && pTexture->mShareCount == 1 && 
+					pTexture->mOwnerClientIndex == static_cast<int32_t>(client.mClientIndex) )
+				{
+					candidates.push_back({&client, texIt.first, pTexture->mLastFrameUsed, GetTextureMemorySize(*pTexture)});
+				}
+			}
+		}
+	}
+
+	// Clients hidden the longest first, then their least recently used textures
+	std::sort(candidates.begin(), candidates.end(), [](const EvictCandidate& a, const EvictCandidate& b){
+		if( a.pClient->mLastVisibleTime != b.pClient->mLastVisibleTime ) return a.pClient->mLastVisibleTime < b.pClient->mLastVisibleTime;
+		if( a.pClient != b.pClient ) return a.pClient->mClientIndex < b.pClient->mClientIndex;
+		return a.lastFrameUsed < b.lastFrameUsed;
+	});
+
+	uint64_t memoryUsage = gTextureMemoryUsage;
+	for(size_t i(0); i < candidates.size() && memoryUsage > budgetBytes; ++i)
+	{
+		candidates[i].pClient->EvictTexture(candidates[i].clientTexID);
+		memoryUsage -= candidates[i].memorySize;
+	}
+}
+
+//=================================================================================================
+uint64_t GetTextureMemoryUsage()
+//=================================================================================================
+{
+	return gTextureMemoryUsage;
 }
 
 //=================================================================================================
@@ -260,19 +394,16 @@ bool CreateTexture_Default(ServerTexture& serverTexture, const NetImgui::Interna
 {
 	if( !serverTexture.mIsCustom && cmdTexture.mpTextureData.Get() != nullptr )
 	{
-		serverTexture.mIsUpdatable = cmdTexture.mUpdatable;
-		serverTexture.mTexData.Create(ImTextureFormat::ImTextureFormat_RGBA32, cmdTexture.mWidth, cmdTexture.mHeight);
-		if( cmdTexture.mFormat == ImTextureFormat::ImTextureFormat_RGBA32 )
+		// Alpha8 textures are kept in their native format when possible (font atlas, 4x less memory)
+		const bool bNativeAlpha8	= cmdTexture.mFormat == ImTextureFormat::ImTextureFormat_Alpha8 && HAL_IsTextureFormatSupported(ImTextureFormat::ImTextureFormat_Alpha8);
+		serverTexture.mIsUpdatable	= cmdTexture.mUpdatable;
+		serverTexture.mTexData.Create(bNativeAlpha8 ? ImTextureFormat::ImTextureFormat_Alpha8 : ImTextureFormat::ImTextureFormat_RGBA32, cmdTexture.mWidth, cmdTexture.mHeight);
+		if( cmdTexture.mFormat == ImTextureFormat::ImTextureFormat_RGBA32 || bNativeAlpha8 )
 		{
 			memcpy(serverTexture.mTexData.Pixels, cmdTexture.mpTextureData.Get(), customDataSize);
 		}
 		else if ( cmdTexture.mFormat == ImTextureFormat::ImTextureFormat_Alpha8) {
-			const uint8_t* pSrcCur	= cmdTexture.mpTextureData.Get();
-			uint32_t* pDestCur		= reinterpret_cast<uint32_t*>(serverTexture.mTexData.GetPixels());
-			uint32_t* pDestEnd		= &pDestCur[cmdTexture.mHeight*cmdTexture.mWidth];
-			while (pDestCur < pDestEnd) {
-				*pDestCur++ = 0x00FFFFFF | (uint64_t(*pSrcCur++)<<24);
-			}
+			ConvertTextureAlpha8ToRGBA32(cmdTexture.mpTextureData.Get(), reinterpret_cast<uint32_t*>(serverTexture.mTexData.GetPixels()), static_cast<size_t>(cmdTexture.mWidth)*static_cast<size_t>(cmdTexture.mHeight));
 		}
 		else {
 			IM_ASSERT_USER_ERROR(0, "Unsupported format");
@@ -286,6 +417,52 @@ bool CreateTexture_Default(ServerTexture& serverTexture, const NetImgui::Interna
 	return false;
 }
 
+//=================================================================================================
+// Alpha8 to RGBA32 expansion, 16 pixels at a time when SSE2 is available
+void ConvertTextureAlpha8ToRGBA32(const uint8_t* pSrc, uint32_t* pDst, size_t pixelCount)
+//=================================================================================================
+{
+	size_t i(0);
+#if NETIMGUI_SERVER_SSE2
+	const __m128i kWhite = _mm_set1_epi8(static_cast<char>(0xFF));
+	for(; i + 16 <= pixelCount; i += 16)
+	{
+		const __m128i alpha	= _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pSrc[i]));
+		const __m128i lo	= _mm_unpacklo_epi8(kWhite, alpha);	// 8x 16bits [0xFF, alpha]
+		const __m128i hi	= _mm_unpackhi_epi8(kWhite, alpha);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&pDst[i+ 0]), _mm_unpacklo_epi16(kWhite, lo)); // 4x 32bits [0xFF, 0xFF, 0xFF, alpha]
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&pDst[i+ 4]), _mm_unpackhi_epi16(kWhite, lo));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&pDst[i+ 8]), _mm_unpacklo_epi16(kWhite, hi));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&pDst[i+12]), _mm_unpackhi_epi16(kWhite, hi));
+	}
+#endif
+	for(; i < pixelCount; ++i){
+		pDst[i] = 0x00FFFFFFu | (static_cast<uint32_t>(pSrc[i]) << 24);
+	}
+}
+
+//=================================================================================================
+ServerTexture* GetTexture(ServerTextureHandle handle)
+//=================================================================================================
+{
+	const uint32_t slotIndex	= static_cast<uint32_t>(handle & 0xFFFFFFFFu);
+	const uint32_t generation	= static_cast<uint32_t>(handle >> 32);
+	if( slotIndex < static_cast<uint32_t>(gServerTextures.size()) && gServerTextures[slotIndex].mGeneration == generation ){
+		return gServerTextures[slotIndex].mpTexture;
+	}
+	return nullptr;
+}
+
+//=================================================================================================
+void MarkTexturePending(ServerTexture& serverTexture)
+//=================================================================================================
+{
+	if( !serverTexture.mIsPending && serverTexture.mHandle != kServerTextureInvalid ){
+		serverTexture.mIsPending = 1u;
+		gServerTexturesPending.push_back(serverTexture.mHandle);
+	}
+}
+
 //=================================================================================================
 ServerTexture* CreateTexture(const NetImgui::Internal::CmdTexture& cmdTexture, uint32_t textureDataSize)
 //=================================================================================================
@@ -299,7 +476,21 @@ ServerTexture* CreateTexture(const NetImgui::Internal::CmdTexture& cmdTexture, u
 		if(	CreateTexture_Custom(*serverTex, cmdTexture, textureDataSize) ||
 			CreateTexture_Default(*serverTex, cmdTexture, textureDataSize) )
 		{
-			gServerTextures.push_back(serverTex);
+			uint32_t slotIndex = static_cast<uint32_t>(gServerTextures.size());
+			if( !gServerTexturesFree.empty() ){
+				slotIndex = gServerTexturesFree.back();
+				gServerTexturesFree.pop_back();
+			}
+			else{
+				gServerTextures.push_back(ServerTextureSlot());
+			}
+			gServerTextures[slotIndex].mpTexture	= serverTex;
+			serverTex->mHandle						= (static_cast<uint64_t>(gServerTextures[slotIndex].mGeneration) << 32) | slotIndex;
+			MarkTexturePending(*serverTex);
+			if( cmdTexture.mContentHash != 0 && !serverTex->mIsCustom && gTextureCache.find(cmdTexture.mContentHash) == gTextureCache.end() ){
+				serverTex->mContentHash = cmdTexture.mContentHash;
+				gTextureCache.insert({cmdTexture.mContentHash, serverTex});
+			}
 		}
 		else
 		{
@@ -310,6 +501,81 @@ ServerTexture* CreateTexture(const NetImgui::Internal::CmdTexture& cmdTexture, u
 	return serverTex;
 }
 
+//=================================================================================================
+ServerTexture* AcquireSharedTexture(uint64_t contentHash, bool isUpdatable)
+//=================================================================================================
+{
+	auto texIt = contentHash != 0 ? gTextureCache.find(contentHash) : gTextureCache.end();
+	if( texIt != gTextureCache.end() && texIt->second->mIsUpdatable == isUpdatable && !texIt->second->mTexData.WantDestroyNextFrame )
+	{
+		texIt->second->mShareCount++;
+		return texIt->second;
+	}
+	return nullptr;
+}
+
+//=================================================================================================
+// Texture is only deleted once the last client referencing it has released it. It then 
+// becomes owned by this last client, to wait on its drawn frames before releasing the resource
+void ReleaseTexture(ServerTexture& serverTexture, const RemoteClient::Client& client)
+//=================================================================================================
+{
+	if( serverTexture.mShareCount > 1 ){
+		serverTexture.mShareCount--;
+		return;
+	}
+
+	if( serverTexture.mContentHash != 0 ){
+		auto texIt = gTextureCache.find(serverTexture.mContentHash);
+		if( texIt != gTextureCache.end() && texIt->second == &serverTexture ){
+			gTextureCache.erase(texIt);
+		}
+		serverTexture.mContentHash = 0;
+	}
+
+	if( serverTexture.mOwnerClientIndex != static_cast<int32_t>(client.mClientIndex) ){
+		serverTexture.mOwnerClientIndex	= static_cast<int32_t>(client.mClientIndex);
+		serverTexture.mLastFrameUsed	= client.mpImguiDrawData ? client.mpImguiDrawData->mFrameIndex : 0;
+	}
+	serverTexture.mShareCount = 0;
+	serverTexture.MarkForDelete();
+	MarkTexturePending(serverTexture);
+}
+
+//=================================================================================================
+// Copy-on-write of shared textures. The modified texture must not affect other clients
+ServerTexture* UnshareTexture(ServerTexture& serverTexture, const RemoteClient::Client& client)
+//=================================================================================================
+{
+	ServerTexture* pServerTex = &serverTexture;
+	if( serverTexture.mShareCount > 1 && serverTexture.mTexData.Pixels != nullptr )
+	{
+		NetImgui::Internal::CmdTexture cmdTexture;
+		cmdTexture.mTextureClientID	= serverTexture.mClientTexID;
+		cmdTexture.mFormat			= serverTexture.mTexData.Format == ImTextureFormat_Alpha8 ? NetImgui::eTexFormat::kTexFmtA8 : NetImgui::eTexFormat::kTexFmtRGBA8;
+		cmdTexture.mUpdatable		= serverTexture.mIsUpdatable;
+		cmdTexture.mWidth			= static_cast<uint16_t>(serverTexture.mTexData.Width);
+		cmdTexture.mHeight			= static_cast<uint16_t>(serverTexture.mTexData.Height);
+		cmdTexture.mpTextureData.SetPtr(serverTexture.mTexData.Pixels);
+		pServerTex = CreateTexture(cmdTexture, static_cast<uint32_t>(serverTexture.mTexData.GetSizeInBytes()));
+		if( pServerTex ){
+			pServerTex->mOwnerClientIndex	= static_cast<int32_t>(client.mClientIndex);
+			pServerTex->mTexData.UseColors	= serverTexture.mTexData.UseColors;
+			ReleaseTexture(serverTexture, client);
+		}
+	}
+	else if( serverTexture.mContentHash != 0 )
+	{
+		// Not shared with anyone, stop advertising content that is about to change
+		auto texIt = gTextureCache.find(serverTexture.mContentHash);
+		if( texIt != gTextureCache.end() && texIt->second == &serverTexture ){
+			gTextureCache.erase(texIt);
+		}
+		serverTexture.mContentHash = 0;
+	}
+	return pServerTex;
+}
+
 //=================================================================================================
 // Initialize all needed fonts by the NetImguiServer application
 void LoadFonts()
@@ -363,9 +629,10 @@ WindowPlacement GetWindowPlacement()
 void UpdateClientDraw()
 //=================================================================================================
 {
-	for (uint32_t i(0); i < RemoteClient::Client::GetCountMax(); ++i)
+	RemoteClient::Client::UpdateActiveList();
+	for (uint32_t i(0); i < RemoteClient::Client::GetActiveCount(); ++i)
 	{
-		RemoteClient::Client& client = RemoteClient::Client::Get(i);
+		RemoteClient::Client& client = RemoteClient::Client::GetActive(i);
 		if( client.mbIsConnected )
 		{
 			if (client.mbIsReleased) {
@@ -376,6 +643,8 @@ void UpdateClientDraw()
 				client.ProcessPendingTextureCmds();
 				if( client.mbIsVisible )
 				{
+					client.mLastVisibleTime = std::chrono::steady_clock::now();
+
 					// Update the RenderTarget destination of each client, of size was updated
 					if (client.mAreaSizeX > 0 && client.mAreaSizeY > 0 && (!client.mpHAL_AreaRT || client.mAreaRTSizeX != client.mAreaSizeX || client.mAreaRTSizeY != client.mAreaSizeY))
 					{
@@ -385,21 +654,28 @@ void UpdateClientDraw()
 							client.mAreaRTSizeY		= client.mAreaSizeY;
 							client.mLastUpdateTime	= std::chrono::steady_clock::now() - std::chrono::hours(1); // Will redraw the client
 							client.mBGNeedUpdate	= true;
+							client.MarkRenderDirty();
 						}
 					}
 
 					// Render the remote results
+					// Note: RenderTarget content is kept between frames, only regenerate it when something changed
 					ImDrawData* pDrawData = client.GetImguiDrawData(gServerTextureEmpty->mTexData.GetTexID());
 					if( pDrawData )
 					{
 						DrawClientBackground(client);
-						HAL_RenderDrawData(client, pDrawData);
+						if( client.mRenderDirtyFrames > 0 )
+						{
+							HAL_RenderDrawData(client, pDrawData);
+							client.mRenderDirtyFrames--;
+						}
 					}
 				}
 			}
 		}
 	}
 
+	UpdateTextureBudget();
 	UpdateServerTextures();
 }
 }} // namespace NetImguiServer { namespace App
@@ -45,7 +45,12 @@ namespace NetImguiServer { namespace App
 	// Initialize the font atlas used by the Serve
 	void	LoadFonts();
 
-	// Descriptor of each textures by Server. Format always RGBA8
+	// Generational handle of a texture in the Server registry : [32bits generation][32bits slot index]
+	// Once the texture is deleted and its slot reused, the previous handle resolves to nullptr
+	using ServerTextureHandle							= uint64_t;
+	constexpr ServerTextureHandle kServerTextureInvalid	= 0u;
+
+	// Descriptor of each textures by Server. Format is RGBA8, or Alpha8 when supported by HAL
 	struct ServerTexture 
 	{
 		inline ServerTexture(){ mTexData.Status = ImTextureStatus_Destroyed; mTexData.RefCount = 1; }
@@ -54,22 +59,38 @@ namespace NetImguiServer { namespace App
 		ImTextureData	mTexData;					// Struct used by backend for texture support
 		ImTextureID		mClientTexID;				// Client UserID associated with this texture
 		uint64_t		mCustomData			= 0u;	// Memory available to custom command
-		uint64_t 		mLastFrameUsed		= 0u;	// Last draw frame this texture was used (needed for resources release)
+		uint64_t 		mLastFrameUsed		= 0u;	// Last draw frame this texture was used by its owner (needed for resources release)
+		uint64_t		mContentHash		= 0u;	// Hash of the texture content, when shareable between clients (0 otherwise)
+		uint64_t		mMemorySize			= 0u;	// Memory accounted for this texture in total usage (GPU and CPU copy)
+		ServerTextureHandle mHandle			= kServerTextureInvalid; // Registry entry of this texture
 		int32_t 		mOwnerClientIndex	= -1;	// Client that created this texture (if any)
+		uint32_t		mShareCount			= 1u;	// Number of client textures referencing this texture
 		uint8_t			mIsCustom			= 0u;	// Format handled by custom version of NetImguiServer modified by library user
 		uint8_t			mIsUpdatable		= 0u;	// True when textures can be updated (font)
-		uint8_t			mPadding[6]			= {};
+		uint8_t			mIsPending			= 0u;	// True when queued for processing in next 'UpdateServerTextures'
+		uint8_t			mPadding[5]			= {};
 	};
 
 	//=============================================================================================
 	// Handling of texture data
 	//=============================================================================================
 	ServerTexture* CreateTexture(const NetImgui::Internal::CmdTexture& cmdTexture, uint32_t customDataSize);
+	ServerTexture* GetTexture(ServerTextureHandle handle);		// nullptr when texture has been deleted
+	void	MarkTexturePending(ServerTexture& serverTexture);	// Status changed (update, deletion, ...), needs processing in next 'UpdateServerTextures'
+
+	// Textures with identical content are shared between clients (font atlas, common images, ...)
+	ServerTexture* AcquireSharedTexture(uint64_t contentHash, bool isUpdatable);			// Returns an already created texture with same content (if any), and add a reference to it
+	void	ReleaseTexture(ServerTexture& serverTexture, const RemoteClient::Client& client);	// Remove a client reference to this texture, deleting it when last one
+	ServerTexture* UnshareTexture(ServerTexture& serverTexture, const RemoteClient::Client& client);	// Before modifying a texture content, get a copy exclusive to this client
+	uint64_t GetTextureMemoryUsage();	// Memory used by all textures (GPU and CPU copy), updated once per frame
 
 	// Library users can implement their own texture format (on client/server). Useful for vidoe streaming, new format, etc.
 	bool	CreateTexture_Custom(ServerTexture& serverTexture, const NetImgui::Internal::CmdTexture& cmdTexture, uint32_t customDataSize);
 	bool	DestroyTexture_Custom(ServerTexture& serverTexture, const NetImgui::Internal::CmdTexture& cmdTexture, uint32_t customDataSize);
 
+	// Expand Alpha8 pixels to RGBA32 (white color), for platforms without native Alpha8 texture support
+	void	ConvertTextureAlpha8ToRGBA32(const uint8_t* pSrc, uint32_t* pDst, size_t pixelCount);
+
 	//=============================================================================================
 	// Note (H)ardware (A)bstraction (L)ayer
 	//		When porting the 'NetImgui Server' application to other platform, 
@@ -94,4 +115,8 @@ namespace NetImguiServer { namespace App
 	bool	HAL_CreateRenderTarget(uint16_t Width, uint16_t Height, void*& pOutRT, ImTextureData& OutTexture );
 	// Free a RenderTarget resource
 	void	HAL_DestroyRenderTarget(void*& pOutRT, ImTextureData& OutTexture );
+	// Return true when textures of this format can be displayed without conversion (always true for RGBA32, handled by Dear ImGui's backend)
+	bool	HAL_IsTextureFormatSupported(ImTextureFormat Format);
+	// Process pending creation/update/destruction of a texture in a format not supported by Dear ImGui's backend (other than RGBA32)
+	void	HAL_UpdateTexture(ImTextureData& Texture);
 }}
@@ -17,6 +17,7 @@ static constexpr char kConfigField_ServerRefreshActive[]		= "RefreshFPSActive";
 static constexpr char kConfigField_ServerRefreshInactive[]		= "RefreshFPSInactive";
 static constexpr char kConfigField_ServerDPIScaleRatio[]		= "DPIScaleRatio";
 static constexpr char kConfigField_ServerCompressionEnable[]	= "CompressionEnable";
+static constexpr char kConfigField_ServerTextureBudgetMB[]		= "TextureBudgetMB";
 static constexpr char kConfigField_ServerFontSize[]				= "ServerFontSize";
 static constexpr char kConfigField_ServerWindowPlacementX[]		= "ServerWindowPlacementX";
 static constexpr char kConfigField_ServerWindowPlacementY[]		= "ServerWindowPlacementY";
@@ -39,6 +40,7 @@ float		Server::sRefreshFPSActive	= 30.f;
 float		Server::sRefreshFPSInactive	= 30.f;
 float		Server::sDPIScaleRatio		= 1.f;
 bool		Server::sCompressionEnable	= true;
+uint32_t	Server::sTextureBudgetMB	= 0;
 float		Server::sFontSize			= 16.f;
 int			Server::sWindowPlacement[4]	= {100, 100, 1280, 1024};
 bool 		Server::sWindowMaximized	= false;
@@ -280,6 +282,7 @@ void Client::SaveConfigFile(eConfigType configFileType, bool writeServerSettings
 		configRoot[kConfigField_ServerRefreshInactive]		= Server::sRefreshFPSInactive;
 		configRoot[kConfigField_ServerDPIScaleRatio]		= Server::sDPIScaleRatio;
 		configRoot[kConfigField_ServerCompressionEnable]	= Server::sCompressionEnable;
+		configRoot[kConfigField_ServerTextureBudgetMB]		= Server::sTextureBudgetMB;
 		configRoot[kConfigField_ServerFontSize]				= Server::sFontSize;
 		configRoot[kConfigField_ServerWindowPlacementX]		= Server::sWindowPlacement[0];
 		configRoot[kConfigField_ServerWindowPlacementY]		= Server::sWindowPlacement[1];
@@ -353,6 +356,7 @@ void Client::LoadConfigFile(eConfigType configFileType)
 	Server::sRefreshFPSInactive	= GetPropertyValue(configRoot, kConfigField_ServerRefreshInactive,	Server::sRefreshFPSInactive);
 	Server::sDPIScaleRatio		= GetPropertyValue(configRoot, kConfigField_ServerDPIScaleRatio,	Server::sDPIScaleRatio);
 	Server::sCompressionEnable	= GetPropertyValue(configRoot, kConfigField_ServerCompressionEnable,Server::sCompressionEnable);
+	Server::sTextureBudgetMB	= GetPropertyValue(configRoot, kConfigField_ServerTextureBudgetMB,	Server::sTextureBudgetMB);
 	Server::sFontSize			= GetPropertyValue(configRoot, kConfigField_ServerFontSize,			Server::sFontSize);
 	Server::sWindowPlacement[0] = GetPropertyValue(configRoot, kConfigField_ServerWindowPlacementX, Server::sWindowPlacement[0]);
 	Server::sWindowPlacement[1] = GetPropertyValue(configRoot, kConfigField_ServerWindowPlacementY, Server::sWindowPlacement[1]);
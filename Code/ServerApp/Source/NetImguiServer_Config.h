@@ -115,6 +115,7 @@ struct Server
 	static float	sRefreshFPSInactive;	//!< Refresh rate of inactive Window
 	static float	sDPIScaleRatio;			//!< Ratio of DPI scale applied to Font size (helps with high resolution monitor, default 1.0)
 	static bool		sCompressionEnable;		//!< Ask the clients to compress their data before transmission
+	static uint32_t	sTextureBudgetMB;		//!< Texture memory the Server tries to stay under, by releasing textures of hidden clients (0 for unlimited)
 	static float 	sFontSize;				//!< Font size used for Server UI
 	static int		sWindowPlacement[4];	//!< Main window position and size (x,y,width,height)
 	static bool		sWindowMaximized;
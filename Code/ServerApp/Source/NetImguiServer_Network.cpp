@@ -30,7 +30,7 @@ void Communications_Incoming_CmdTexture(RemoteClient::Client& Client)
 	pCmdTexture->mpTextureData.ToPointer();
 
 	// For debug tracking
-	uint32_t idx = Client.mTextureHistoryIndex % IM_ARRAYSIZE(Client.mTextureHistory);
+	uint32_t idx = Client.mTextureHistoryIndex % static_cast<uint32_t>(Client.mTextureHistory.size());
 	Client.mTextureHistory[idx].UpdateId 			= Client.mTextureHistoryIndex++;
 	Client.mTextureHistory[idx].Frame				= Client.mLastDrawFrameIndex;
 	Client.mTextureHistory[idx].ClientId			= pCmdTexture->mTextureClientID;
@@ -83,7 +83,10 @@ void Communications_Incoming_CmdClipboard(RemoteClient::Client& Client)
 //=================================================================================================
 void Communications_Incoming(RemoteClient::Client& Client)
 {
-	if( ::Network::DataReceivePending(Client.mpSocket) )
+	// Too much texture data waiting to be processed by main thread, stop reading new commands until 
+	// it catches up (lets network flow control slow down the client instead of stalling com thread)
+	const bool bBackpressure = Client.mPendingRcv.IsReady() && Client.IsPendingTextureFull();
+	if( !bBackpressure && ::Network::DataReceivePending(Client.mpSocket) )
 	{
 		//-----------------------------------------------------------------------------------------
 		// 1. Ready to receive new command, starts the process by reading Header
@@ -131,6 +134,7 @@ void Communications_Incoming(RemoteClient::Client& Client)
 						// Commands not received in main loop, by Server
 					case NetImgui::Internal::CmdHeader::eCommands::Version:
 					case NetImgui::Internal::CmdHeader::eCommands::Input:
+					case NetImgui::Internal::CmdHeader::eCommands::TextureRequest:
 					case NetImgui::Internal::CmdHeader::eCommands::Count: 	break;
 				}
 			}
@@ -190,6 +194,15 @@ void Communications_Outgoing(RemoteClient::Client& Client)
 		}
 	}
 
+	if( Client.mPendingSend.IsReady() )
+	{
+		NetImgui::Internal::CmdTextureRequest* pTextureRequestCmd = Client.TakePendingTextureRequest();
+		if( pTextureRequestCmd ){
+			Client.mPendingSend.pCommand 				= pTextureRequestCmd;
+			Client.mPendingSend.bAutoFree				= true;
+		}
+	}
+
 	if( Client.mPendingSend.IsReady() )
 	{
 		NetImgui::Internal::CmdInput* pInputCmd			= Client.TakePendingInput();
@@ -346,7 +359,7 @@ void NetworkConnectionNew(NetImgui::Internal::Network::SocketInfo* pClientSocket
 		NetImgui::Internal::Network::Disconnect(pClientSocket);
 		if (!gbShutdown) {
 			if (pNewClient){
-				pNewClient->mbIsFree = true;
+				RemoteClient::Client::ReleaseIndex(pNewClient->mClientIndex);
 				printf("Error connecting to client '%s:%i' (%s)\n", pNewClient->mConnectHost, pNewClient->mConnectPort, zErrorMsg);
 			}
 			else {
@@ -389,7 +402,6 @@ void NetworkConnectRequest_Receive()
 				{
 					RemoteClient::Client& newClient	= RemoteClient::Client::Get(freeIndex);
 					newClient.mClientConfigID		= NetImguiServer::Config::Client::kInvalidRuntimeID;
-					newClient.mClientIndex			= freeIndex;
 					NetImguiServer::App::HAL_GetSocketInfo(pClientSocket, newClient.mConnectHost, sizeof(newClient.mConnectHost), newClient.mConnectPort);
 					NetworkConnectionNew(pClientSocket, &newClient, false);
 				}
@@ -446,7 +458,6 @@ void NetworkConnectRequest_Send()
 					NetImgui::Internal::StringCopy(newClient.mInfoName, clientConfig.mClientName);
 					newClient.mConnectPort		= clientConfig.mHostPort;
 					newClient.mClientConfigID	= clientConfigID;
-					newClient.mClientIndex		= freeIndex;
 				}
 				NetImguiServer::App::HAL_GetSocketInfo(pClientSocket, newClient.mConnectHost, sizeof(newClient.mConnectHost), newClient.mConnectPort);
 				NetworkConnectionNew(pClientSocket, &newClient, ConnectForce);
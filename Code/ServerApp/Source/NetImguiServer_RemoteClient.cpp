@@ -2,14 +2,28 @@
 #include "NetImguiServer_RemoteClient.h"
 #include "NetImguiServer_Config.h"
 #include "NetImguiServer_UI.h"
+#include "NetImguiServer_Worker.h"
 #include <Private/NetImgui_CmdPackets.h>
 #include <algorithm>
+#include <mutex>
+
+// Maximum time spent processing texture commands of a client each frame, 
+// so a large batch of textures doesn't stall the Server UI (remaining commands are processed next frames)
+static constexpr std::chrono::microseconds kPendingTextureTimeSlice(4000);
 
 namespace NetImguiServer { namespace RemoteClient
 {
 
-static Client* gpClients		= nullptr;	// Table of all potentially connected clients to this server
-static uint32_t gClientCountMax = 0;
+// Clients are allocated in fixed size blocks that are never moved or freed until shutdown, 
+// letting com threads safely keep a reference on their client while the table grows
+static constexpr uint32_t	kClientBlockSize		= 16;
+static constexpr uint32_t	kClientBlockCountMax	= 1024;
+static std::atomic<Client*>	gpClientBlocks[kClientBlockCountMax];	// Table of all allocated client blocks
+static std::atomic_uint32_t	gClientCountMax(0);						// Number of allocated client slots
+static std::mutex			gClientListLock;						// Protects free/active lists (modified by network threads and main thread)
+static ImVector<uint32_t>	gClientFreeList;						// Allocated client slots not assigned to a connection
+static ImVector<uint32_t>	gClientActiveList;						// Client slots assigned to a connection
+static ImVector<uint32_t>	gClientActiveListMain;					// Copy of 'gClientActiveList' safe to iterate on main thread (refreshed once per frame)
 
 NetImguiImDrawData::NetImguiImDrawData()
 : mCommandList(nullptr)
@@ -20,12 +34,21 @@ NetImguiImDrawData::NetImguiImDrawData()
 
 
 Client::Client()
-: mPendingTextureReadIndex(0)
-, mPendingTextureWriteIndex(0)
+: mFrameIndexAck(0)
+, mbVideoReferences(false)
+, mpPendingTextureIn(nullptr)
+, mPendingTextureBytes(0)
+, mPendingTextureRcvCount(0)
 , mbIsFree(true)
 , mbCompressionSkipOncePending(false)
 , mbDisconnectPending(false)
 , mClientConfigID(NetImguiServer::Config::Client::kInvalidRuntimeID)
+, mStatsDeltaHitPct(0.f)
+, mStatsVideoFrames(0)
+, mStatsVideoBytesRcvd(0)
+, mStatsVideoBytesRaw(0)
+, mStatsVideoDecodeMs(0.f)
+, mStatsVideoLatencyMs(0.f)
 {
 }
 
@@ -34,30 +57,106 @@ Client::~Client()
 	Uninitialize();
 }
 
+//=================================================================================================
+// Queue a received DrawFrame command for decoding on a worker thread (com thread)
+//=================================================================================================
 void Client::ReceiveDrawFrame(NetImgui::Internal::CmdDrawFrame* pFrameData)
 {
+	{
+		std::lock_guard<std::mutex> guard(mReceivedFramesLock);
+		mReceivedFrames.push_back({pFrameData, mPendingTextureRcvCount});
+	}
+	NetImguiServer::Worker::AddJob(DecodeDrawFrameJob, this);
+}
+
+//=================================================================================================
+// Decode all DrawFrames waiting for this client (worker thread)
+// Only one worker can decode a client at a time, since frames are compressed against previous one.
+// Other workers give up right away, with active one processing their frames.
+//=================================================================================================
+void Client::DecodeDrawFrameJob(void* pUserData)
+{
+	Client* pClient = reinterpret_cast<Client*>(pUserData);
+	bool bPending	= true;
+	while( bPending && pClient->mDecodeLock.try_lock() )
+	{
+		ReceivedFrame receivedFrame = {};
+		do {
+			{
+				std::lock_guard<std::mutex> guard(pClient->mReceivedFramesLock);
+				bPending = !pClient->mReceivedFrames.empty();
+				if( bPending ){
+					receivedFrame = pClient->mReceivedFrames.front();
+					pClient->mReceivedFrames.erase(pClient->mReceivedFrames.begin());
+				}
+			}
+			if( bPending ){
+				pClient->DecodeDrawFrame(receivedFrame);
+			}
+		} while( bPending );
+		pClient->mDecodeLock.unlock();
+
+		// A new frame could have been added after our last check, but before lock release
+		std::lock_guard<std::mutex> guard(pClient->mReceivedFramesLock);
+		bPending = !pClient->mReceivedFrames.empty();
+	}
+}
+
+void Client::DecodeDrawFrame(const ReceivedFrame& receivedFrame)
+{
+	NetImgui::Internal::CmdDrawFrame* pFrameData = receivedFrame.mpCmdDrawFrame;
 	if( pFrameData->mCompressed )
 	{
-		if( mpFrameDrawPrev != nullptr && (mpFrameDrawPrev->mFrameIndex+1) == pFrameData->mFrameIndex ) {
-			NetImgui::Internal::CmdDrawFrame* pUncompressedFrame = NetImgui::Internal::DecompressCmdDrawFrame(mpFrameDrawPrev, pFrameData);
+		auto refIt = std::find_if(mFrameDrawRefs.begin(), mFrameDrawRefs.end(), [pFrameData](const NetImgui::Internal::CmdDrawFrame* pRef){ return pRef->mFrameIndex == pFrameData->mFrameIndexRef; });
+		if( refIt != mFrameDrawRefs.end() ) {
+			// Update delta compression efficiency
+			constexpr float kHysteresis	= 0.025f; // Between 0 to 1.0
+			uint32_t groupFoundCount(0);
+			for(uint32_t i(0); i < pFrameData->mDrawGroupCount; ++i){
+				groupFoundCount += pFrameData->mpDrawGroups[i].mDrawGroupIdxPrev < (*refIt)->mDrawGroupCount ? 1 : 0;
+			}
+			float deltaHitPct	= pFrameData->mDrawGroupCount > 0 ? 100.f * static_cast<float>(groupFoundCount) / static_cast<float>(pFrameData->mDrawGroupCount) : 100.f;
+			mStatsDeltaHitPct	= mStatsDeltaHitPct.load() * (1.f-kHysteresis) + deltaHitPct*kHysteresis;
+
+			NetImgui::Internal::CmdDrawFrame* pUncompressedFrame = NetImgui::Internal::DecompressCmdDrawFrame(*refIt, pFrameData);
 			netImguiDeleteSafe( pFrameData );
 			pFrameData = pUncompressedFrame;
+
+			// Client never goes back to frames older than its reference
+			for(auto it = mFrameDrawRefs.begin(); it != refIt; ++it){
+				netImguiDelete(*it);
+			}
+			mFrameDrawRefs.erase(mFrameDrawRefs.begin(), refIt);
 		}
-		// Missing previous frame data
-		// ignore this drawframe and request a new uncompressed one to be able to resume display
+		// Missing reference frame data
+		// ignore this drawframe and request a new uncompressed one (only once) to be able to resume display
 		else
 		{
-			mbCompressionSkipOncePending = true;
+			if( !mbKeyFrameRequested ){
+				mbCompressionSkipOncePending	= true;
+				mbKeyFrameRequested				= true;
+			}
 			netImguiDeleteSafe( pFrameData );
 		}
 	}
+	// Keyframe, previous references are no longer used by client
+	else
+	{
+		ReleaseFrameDrawRefs();
+		mbKeyFrameRequested = false;
+	}
 
-	netImguiDeleteSafe( mpFrameDrawPrev );
 	if( pFrameData )
 	{
+		// Too many frames waiting on being used as reference, forget the oldest one (after current reference)
+		if( mFrameDrawRefs.size() >= kFrameDrawRefsMax ){
+			netImguiDelete(mFrameDrawRefs[1]);
+			mFrameDrawRefs.erase(mFrameDrawRefs.begin() + 1);
+		}
+
 		// Convert DrawFrame command to Dear Imgui DrawData,
 		// and make it available for main thread to use in rendering
-		ProcessCmdDrawFrame(pFrameData);
+		ProcessCmdDrawFrame(pFrameData, receivedFrame.mTextureCmdCount);
 
 		// Update framerate
 		constexpr float kHysteresis	= 0.025f; // Between 0 to 1.0
@@ -72,14 +171,241 @@ void Client::ReceiveTexture(NetImgui::Internal::CmdTexture* pTextureCmd)
 {
 	if( pTextureCmd )
 	{
-		// Wait for a free spot in the ring buffer
-		while (mPendingTextureWriteIndex - mPendingTextureReadIndex >= IM_ARRAYSIZE(mpPendingTextures)) {
-			std::this_thread::yield();
+		// Compressed textures are decoded by a worker thread. Commands received after one,
+		// must wait behind it in 'mReceivedTextures', to preserve their ordering
+		bool bDecode = NetImgui::Internal::IsTextureFormatCompressed(static_cast<NetImgui::eTexFormat>(pTextureCmd->mFormat)) && 
+					   pTextureCmd->mStatus != NetImgui::Internal::CmdTexture::eType::Destroy;
+		mPendingTextureBytes		+= pTextureCmd->mSize;
+		mPendingTextureRcvCount++;
+		{
+			std::lock_guard<std::mutex> guard(mReceivedTexturesLock);
+			bDecode |= mbVideoReferences; // Worker thread releases video references invalidated by this command
+			if( bDecode || !mReceivedTextures.empty() ){
+				mReceivedTextures.push_back({pTextureCmd, std::chrono::steady_clock::now()});
+				pTextureCmd = nullptr;
+			}
+		}
+		if( pTextureCmd ){
+			AddPendingTextureCmd(pTextureCmd);
+		}
+		else if( bDecode ){
+			NetImguiServer::Worker::AddJob(DecodeTextureJob, this);
+		}
+	}
+}
+
+//=================================================================================================
+// Add the command to the lock-free list (never blocks, com thread stops reading 
+// new commands instead, when too much texture data is waiting to be processed)
+//=================================================================================================
+void Client::AddPendingTextureCmd(NetImgui::Internal::CmdTexture* pTextureCmd)
+{
+	NetImgui::Internal::CmdTexture* pHead	= mpPendingTextureIn.load();
+	do {
+		pTextureCmd->mpNext = pHead;
+	} while( !mpPendingTextureIn.compare_exchange_weak(pHead, pTextureCmd) );
+}
+
+//=================================================================================================
+// Decode all compressed textures waiting for this client (worker thread)
+// Commands are only removed from 'mReceivedTextures' once added to the pending list, so the
+// com thread keeps queuing new ones behind them. Only one worker decodes a client at a time.
+//=================================================================================================
+void Client::DecodeTextureJob(void* pUserData)
+{
+	Client* pClient = reinterpret_cast<Client*>(pUserData);
+	bool bPending	= true;
+	while( bPending && pClient->mDecodeTextureLock.try_lock() )
+	{
+		ReceivedTexture receivedTexture = {};
+		{
+			std::lock_guard<std::mutex> guard(pClient->mReceivedTexturesLock);
+			bPending		= !pClient->mReceivedTextures.empty();
+			receivedTexture	= bPending ? pClient->mReceivedTextures.front() : ReceivedTexture{};
 		}
+		while( receivedTexture.mpCmdTexture )
+		{
+			NetImgui::Internal::CmdTexture* pTextureCmd		= receivedTexture.mpCmdTexture;
+			NetImgui::Internal::CmdTexture* pTextureDecoded = pTextureCmd;
+			const bool bVideo = pTextureCmd->mFormat == NetImgui::eTexFormat::kTexFmtRGBA8_Video && pTextureCmd->mStatus != NetImgui::Internal::CmdTexture::eType::Destroy;
+			if( !bVideo && !pClient->mVideoReferences.empty() ){
+				pClient->mVideoReferences.erase(pTextureCmd->mTextureClientID);
+			}
+
+			if( NetImgui::Internal::IsTextureFormatCompressed(static_cast<NetImgui::eTexFormat>(pTextureCmd->mFormat)) )
+			{
+				pTextureDecoded = bVideo ? pClient->DecodeTextureVideo(receivedTexture) : NetImgui::Internal::DecompressCmdTexture(pTextureCmd);
+				if( pTextureDecoded ){
+					pClient->mPendingTextureBytes += pTextureDecoded->mSize;
+					pClient->mPendingTextureBytes -= pTextureCmd->mSize;
+					NetImgui::Internal::netImguiDelete(pTextureCmd);
+				}
+				// Invalid data, should never happen. Still forward a command that 
+				// will be ignored (keep texture commands count valid) and disconnect
+				else {
+					pTextureDecoded				= pTextureCmd;
+					pTextureDecoded->mStatus	= NetImgui::Internal::CmdTexture::eType::Update;
+					pTextureDecoded->mFormat	= NetImgui::eTexFormat::kTexFmt_Invalid;
+					pClient->mbDisconnectPending= true;
+				}
+			}
+
+			pClient->mbVideoReferences = !pClient->mVideoReferences.empty(); // Before releasing this command, so com thread never misses it
+			std::lock_guard<std::mutex> guard(pClient->mReceivedTexturesLock);
+			pClient->mReceivedTextures.erase(pClient->mReceivedTextures.begin());
+			pClient->AddPendingTextureCmd(pTextureDecoded);
+			receivedTexture = pClient->mReceivedTextures.empty() ? ReceivedTexture{} : pClient->mReceivedTextures.front();
+		}
+		pClient->mDecodeTextureLock.unlock();
+
+		// A new texture could have been added after our last check, but before lock release
+		std::lock_guard<std::mutex> guard(pClient->mReceivedTexturesLock);
+		bPending = !pClient->mReceivedTextures.empty();
+	}
+}
+
+//=================================================================================================
+// Decode a texture received as its difference with the previous content (worker thread)
+// The decoded content becomes the reference of the next one
+//=================================================================================================
+NetImgui::Internal::CmdTexture* Client::DecodeTextureVideo(const ReceivedTexture& receivedTexture)
+{
+	const NetImgui::Internal::CmdTexture& cmdTexture	= *receivedTexture.mpCmdTexture;
+	const bool bKeyFrame								= cmdTexture.mStatus == NetImgui::Internal::CmdTexture::eType::Create;
+	auto timeStart										= std::chrono::steady_clock::now();
+	auto refIt											= mVideoReferences.find(cmdTexture.mTextureClientID);
+	VideoReference* pVideoRef							= refIt != mVideoReferences.end() && !bKeyFrame ? &refIt->second : nullptr;
+	NetImgui::Internal::CmdTexture* pTextureDecoded		= NetImgui::Internal::DecompressCmdTextureVideo(&cmdTexture, pVideoRef ? pVideoRef->mPixels.data() : nullptr, pVideoRef ? pVideoRef->mWidth : 0, pVideoRef ? pVideoRef->mHeight : 0);
+	if( !pTextureDecoded ){
+		return nullptr;
+	}
+
+	const uint8_t* pPixels	= pTextureDecoded->mpTextureData.Get();
+	const size_t linePitch	= NetImgui::GetTexture_BytePerLine(NetImgui::eTexFormat::kTexFmtRGBA8, pTextureDecoded->mWidth);
+	if( bKeyFrame ){
+		VideoReference& videoRef	= mVideoReferences[cmdTexture.mTextureClientID];
+		videoRef.mWidth				= pTextureDecoded->mWidth;
+		videoRef.mHeight			= pTextureDecoded->mHeight;
+		videoRef.mPixels.assign(pPixels, pPixels + linePitch * pTextureDecoded->mHeight);
+	}
+	else{
+		const size_t refPitch = NetImgui::GetTexture_BytePerLine(NetImgui::eTexFormat::kTexFmtRGBA8, pVideoRef->mWidth);
+		for(uint32_t y(0); y < pTextureDecoded->mHeight; ++y){
+			memcpy(&pVideoRef->mPixels[(pTextureDecoded->mOffsetY + y)*refPitch + pTextureDecoded->mOffsetX*4], &pPixels[y*linePitch], linePitch);
+		}
+	}
+
+	// Update statistics
+	constexpr float kHysteresis	= 0.05f; // Between 0 to 1.0
+	auto timeEnd				= std::chrono::steady_clock::now();
+	float decodeMs				= static_cast<float>(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count()) / 1000.f;
+	float latencyMs				= static_cast<float>(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - receivedTexture.mReceivedTime).count()) / 1000.f;
+	mStatsVideoDecodeMs			= mStatsVideoFrames == 0 ? decodeMs : mStatsVideoDecodeMs.load() * (1.f-kHysteresis) + decodeMs*kHysteresis;
+	mStatsVideoLatencyMs		= mStatsVideoFrames == 0 ? latencyMs : mStatsVideoLatencyMs.load() * (1.f-kHysteresis) + latencyMs*kHysteresis;
+	mStatsVideoBytesRcvd		+= cmdTexture.mSize;
+	mStatsVideoBytesRaw			+= pTextureDecoded->mSize;
+	mStatsVideoFrames++;
+	return pTextureDecoded;
+}
+
+//=================================================================================================
+// Move newly received texture commands to the main thread list, restoring their received order
+//=================================================================================================
+void Client::TakePendingTextureCmds()
+{
+	NetImgui::Internal::CmdTexture* pReceived		= mpPendingTextureIn.exchange(nullptr);
+	NetImgui::Internal::CmdTexture* pOrdered		= nullptr;
+	NetImgui::Internal::CmdTexture* pOrderedLast	= pReceived;
+	while( pReceived ){
+		NetImgui::Internal::CmdTexture* pNext		= pReceived->mpNext;
+		pReceived->mpNext							= pOrdered;
+		pOrdered									= pReceived;
+		pReceived									= pNext;
+	}
+
+	if( pOrdered ){
+		if( mpPendingTextureLast ){
+			mpPendingTextureLast->mpNext = pOrdered;
+		}
+		else{
+			mpPendingTextureFirst = pOrdered;
+		}
+		mpPendingTextureLast = pOrderedLast;
+	}
+}
+
+//=================================================================================================
+// Copy a block of texture lines into the server texture, expanding Alpha8 content when the 
+// server texture is RGBA32 (platform without native Alpha8 support)
+//=================================================================================================
+static void CopyTextureLines(uint8_t* pDst, size_t dstPitch, const uint8_t* pSrc, size_t srcPitch, uint32_t width, uint32_t height, bool bExpandAlpha8)
+{
+	if( bExpandAlpha8 )
+	{
+		for(uint32_t y(0); y < height; ++y){
+			NetImguiServer::App::ConvertTextureAlpha8ToRGBA32(&pSrc[y*srcPitch], reinterpret_cast<uint32_t*>(&pDst[y*dstPitch]), width);
+		}
+	}
+	// Full width update, lines are contiguous in both source and destination
+	else if( srcPitch == dstPitch )
+	{
+		memcpy(pDst, pSrc, srcPitch*height);
+	}
+	else
+	{
+		for(uint32_t y(0); y < height; ++y){
+			memcpy(&pDst[y*dstPitch], &pSrc[y*srcPitch], srcPitch);
+		}
+	}
+}
+
+//=================================================================================================
+// Merge the queued upload rectangles of a texture into a minimal set.
+// Rectangles are replaced by their bounding box when it overlaps them, or when the extra 
+// uploaded pixels cost less than issuing another upload (dynamic font atlas sending many glyphs)
+//=================================================================================================
+static void CoalesceTextureUpdates(ImTextureData& tex)
+{
+	constexpr int kUploadCostInPixels	= 64*64;
+	ImVector<ImTextureRect>& updates	= tex.Updates;
+	bool bMerged						= true;
+	while( bMerged )
+	{
+		bMerged = false;
+		for(int i(0); i < updates.Size; ++i)
+		{
+			for(int j(i+1); j < updates.Size; ++j)
+			{
+				const ImTextureRect a(updates[i]), b(updates[j]);
+				int x0			= ImMin(a.x, b.x);
+				int y0			= ImMin(a.y, b.y);
+				int x1			= ImMax(a.x + a.w, b.x + b.w);
+				int y1			= ImMax(a.y + a.h, b.y + b.h);
+				int overlapW	= ImMin(a.x + a.w, b.x + b.w) - ImMax(a.x, b.x);
+				int overlapH	= ImMin(a.y + a.h, b.y + b.h) - ImMax(a.y, b.y);
+				int overlapArea	= overlapW > 0 && overlapH > 0 ? overlapW * overlapH : 0;
+				if( (x1-x0)*(y1-y0) <= a.w*a.h + b.w*b.h - overlapArea + kUploadCostInPixels )
+				{
+					updates[i]	= { (unsigned short)x0, (unsigned short)y0, (unsigned short)(x1-x0), (unsigned short)(y1-y0) };
+					updates.erase_unsorted(&updates[j]);
+					bMerged		= true;
+					--j;
+				}
+			}
+		}
+	}
 
-		uint64_t writeIndex 			= mPendingTextureWriteIndex % IM_ARRAYSIZE(mpPendingTextures);
-		mpPendingTextures[writeIndex]	= pTextureCmd;
-		mPendingTextureWriteIndex		= mPendingTextureWriteIndex + 1;
+	// Bounding box of all queued uploads
+	if( updates.Size > 0 )
+	{
+		int x0(updates[0].x), y0(updates[0].y), x1(updates[0].x + updates[0].w), y1(updates[0].y + updates[0].h);
+		for(const ImTextureRect& rect : updates){
+			x0 = ImMin(x0, (int)rect.x);
+			y0 = ImMin(y0, (int)rect.y);
+			x1 = ImMax(x1, rect.x + rect.w);
+			y1 = ImMax(y1, rect.y + rect.h);
+		}
+		tex.UpdateRect = { (unsigned short)x0, (unsigned short)y0, (unsigned short)(x1-x0), (unsigned short)(y1-y0) };
 	}
 }
 
@@ -88,80 +414,131 @@ void Client::ReceiveTexture(NetImgui::Internal::CmdTexture* pTextureCmd)
 //=================================================================================================
 void Client::ProcessPendingTextureCmds()
 {
-	while( mPendingTextureReadIndex != mPendingTextureWriteIndex )
+	ImVector<ImTextureData*> updatedTextures;
+	TakePendingTextureCmds();
+	auto timeEnd = std::chrono::steady_clock::now() + kPendingTextureTimeSlice;
+	while( mpPendingTextureFirst && std::chrono::steady_clock::now() < timeEnd )
 	{
-		uint64_t readIndex 								= mPendingTextureReadIndex % IM_ARRAYSIZE(mpPendingTextures);
-		NetImgui::Internal::CmdTexture* pTextureCmd 	= mpPendingTextures[readIndex];
+		NetImgui::Internal::CmdTexture* pTextureCmd 	= mpPendingTextureFirst;
+		mpPendingTextureFirst							= pTextureCmd->mpNext;
+		mpPendingTextureLast							= mpPendingTextureFirst ? mpPendingTextureLast : nullptr;
 		auto texIt										= mTextureTable.find(pTextureCmd->mTextureClientID);
 		NetImguiServer::App::ServerTexture* serverTex	= texIt != mTextureTable.end() ? texIt->second : nullptr;
 
 		bool isCreate			= pTextureCmd->mStatus == NetImgui::Internal::CmdTexture::eType::Create && pTextureCmd->mFormat != NetImgui::eTexFormat::kTexFmt_Invalid;
-		bool isUpdate			= pTextureCmd->mStatus == NetImgui::Internal::CmdTexture::eType::Update && pTextureCmd->mFormat != NetImgui::eTexFormat::kTexFmtCustom;
+		bool isUpdate			= pTextureCmd->mStatus == NetImgui::Internal::CmdTexture::eType::Update && pTextureCmd->mFormat != NetImgui::eTexFormat::kTexFmtCustom && pTextureCmd->mFormat != NetImgui::eTexFormat::kTexFmt_Invalid;
 		uint32_t texDataSize	= pTextureCmd->mSize - sizeof(NetImgui::Internal::CmdTexture);
 
 		// Delete a texture on request or when creating new one with same ClientTextureID
 		if( !isUpdate && serverTex )
 		{
-			serverTex->MarkForDelete();
+			NetImguiServer::App::ReleaseTexture(*serverTex, *this);
 			mTextureTable.erase(texIt);
 		}
+		if( !isUpdate ){
+			mEvictedTextures.erase(pTextureCmd->mTextureClientID);
+		}
 
 		// Add a texture
 		if( isCreate ) 
 		{
-			serverTex = NetImguiServer::App::CreateTexture(*pTextureCmd, texDataSize);
+			// Reuse texture with identical content already received (from any client)
+			serverTex = NetImguiServer::App::AcquireSharedTexture(pTextureCmd->mContentHash, pTextureCmd->mUpdatable != 0);
+			if( !serverTex && !pTextureCmd->mPayloadSkipped ){
+				serverTex = NetImguiServer::App::CreateTexture(*pTextureCmd, texDataSize);
+				if( serverTex ){
+					serverTex->mOwnerClientIndex = static_cast<int32_t>(mClientIndex);
+				}
+			}
 			if( serverTex ){
-				serverTex->mOwnerClientIndex = static_cast<int32_t>(mClientIndex);
 				mTextureTable.insert({pTextureCmd->mTextureClientID, serverTex} );
+				mbMissingTexturesReceived = true; // Might be needed by the displayed DrawData (requested again after an eviction or skipped payload)
+			}
+			// Client didn't send the pixel data, and we don't have it. Ask for it
+			else if( pTextureCmd->mPayloadSkipped ){
+				std::lock_guard<std::mutex> guard(mPendingTextureRequestLock);
+				mPendingTextureRequests.push_back({pTextureCmd->mTextureClientID, pTextureCmd->mContentHash});
 			}
 		}
 		// Update a Texture
 		else if(isUpdate && serverTex && serverTex->mTexData.Status != ImTextureStatus::ImTextureStatus_WantDestroy && serverTex->mTexData.Status != ImTextureStatus::ImTextureStatus_Destroyed)
 		{
+			// Shared textures get their own copy before being modified
+			if( serverTex->mContentHash != 0 ){
+				NetImguiServer::App::ServerTexture* serverTexUnshared = NetImguiServer::App::UnshareTexture(*serverTex, *this);
+				if( serverTexUnshared && serverTexUnshared != serverTex ){
+					texIt->second	= serverTexUnshared;
+					serverTex		= serverTexUnshared;
+				}
+			}
+
 			auto TexFormat = static_cast<NetImgui::eTexFormat>(pTextureCmd->mFormat);
 			if( serverTex->mTexData.Width < (int)(pTextureCmd->mWidth + pTextureCmd->mOffsetX) || 
-				serverTex->mTexData.Height < (int)(pTextureCmd->mHeight + pTextureCmd->mOffsetY) )
+				serverTex->mTexData.Height < (int)(pTextureCmd->mHeight + pTextureCmd->mOffsetY) ||
+				serverTex->mTexData.Pixels == nullptr )
 			{
 				// Update bigger than texture should not happen, but left here as a precaution to avoid 
 				// memory corruption. Could happen if there's an error with client/server re-using a texture ID somehow
+				// Also ignore updates of textures not created as updatable (pixels released after upload)
 			}
 			else
 			{
 				size_t SrcLineBytes 	= NetImgui::GetTexture_BytePerLine(TexFormat, static_cast<uint32_t>(pTextureCmd->mWidth));
-				size_t DstLineBytes 	= NetImgui::GetTexture_BytePerLine(TexFormat, static_cast<uint32_t>(serverTex->mTexData.Width));
-				size_t OffsetBytes		= (pTextureCmd->mOffsetY*DstLineBytes) + NetImgui::GetTexture_BytePerLine(TexFormat, pTextureCmd->mOffsetX);
-				const uint8_t* pDataSrc = pTextureCmd->mpTextureData.Get();
-				uint8_t* pDataDst 		= reinterpret_cast<uint8_t*>(serverTex->mTexData.GetPixels());
-				for(uint64_t y(0); y < pTextureCmd->mHeight; ++y)
-				{
-					memcpy(	&pDataDst[OffsetBytes+(y*DstLineBytes)],
-							&pDataSrc[y*SrcLineBytes], SrcLineBytes);
-				}
+				size_t DstLineBytes 	= static_cast<size_t>(serverTex->mTexData.GetPitch());
+				uint8_t* pDataDst 		= reinterpret_cast<uint8_t*>(serverTex->mTexData.GetPixelsAt(pTextureCmd->mOffsetX, pTextureCmd->mOffsetY));
+				const bool bExpandAlpha8= TexFormat == NetImgui::eTexFormat::kTexFmtA8 && serverTex->mTexData.Format == ImTextureFormat_RGBA32;
+				CopyTextureLines(pDataDst, DstLineBytes, pTextureCmd->mpTextureData.Get(), SrcLineBytes, pTextureCmd->mWidth, pTextureCmd->mHeight, bExpandAlpha8);
 
 				// No need to queue if status is _WantCreate
+				// Note: Upload rectangles are merged after all pending commands have been processed
 				if (serverTex->mTexData.Status != ImTextureStatus_WantCreate)
 				{
-					// Following code mostly copied from ImFontAtlasTextureBlockQueueUpload
 					ImTextureData* tex = &serverTex->mTexData;
 					ImTextureRect req = { 	(unsigned short)pTextureCmd->mOffsetX, (unsigned short)pTextureCmd->mOffsetY, 
 											(unsigned short)pTextureCmd->mWidth, (unsigned short)pTextureCmd->mHeight };
-					int new_x1 = ImMax(tex->UpdateRect.w == 0 ? 0 : tex->UpdateRect.x + tex->UpdateRect.w, req.x + req.w);
-					int new_y1 = ImMax(tex->UpdateRect.h == 0 ? 0 : tex->UpdateRect.y + tex->UpdateRect.h, req.y + req.h);
-					tex->UpdateRect.x = ImMin(tex->UpdateRect.x, req.x);
-					tex->UpdateRect.y = ImMin(tex->UpdateRect.y, req.y);
-					tex->UpdateRect.w = (unsigned short)(new_x1 - tex->UpdateRect.x);
-					tex->UpdateRect.h = (unsigned short)(new_y1 - tex->UpdateRect.y);
 					tex->UsedRect.x = ImMin(tex->UsedRect.x, req.x);
 					tex->UsedRect.y = ImMin(tex->UsedRect.y, req.y);
 					tex->UsedRect.w = (unsigned short)(ImMax(tex->UsedRect.x + tex->UsedRect.w, req.x + req.w) - tex->UsedRect.x);
 					tex->UsedRect.h = (unsigned short)(ImMax(tex->UsedRect.y + tex->UsedRect.h, req.y + req.h) - tex->UsedRect.y);
 					tex->Status = ImTextureStatus_WantUpdates;
 					tex->Updates.push_back(req);
+					NetImguiServer::App::MarkTexturePending(*serverTex);
+					if( !updatedTextures.contains(tex) ){
+						updatedTextures.push_back(tex);
+					}
 				}
+				// Texture content is only uploaded by the backend after this frame's render, also redraw the next one
+				MarkRenderDirty(2);
 			}
 		}
+		mPendingTextureBytes -= pTextureCmd->mSize;
+		mPendingTextureDoneCount++;
 		NetImgui::Internal::netImguiDeleteSafe(pTextureCmd);
-		mPendingTextureReadIndex = mPendingTextureReadIndex + 1;
+	}
+
+	for(ImTextureData* tex : updatedTextures){
+		CoalesceTextureUpdates(*tex);
+	}
+}
+
+//=================================================================================================
+// Release a texture to lower the Server memory usage. Once needed again by a DrawFrame, 
+// a 'CmdTextureRequest' asks the client to send it again
+//=================================================================================================
+void Client::EvictTexture(uint64_t clientTexID)
+{
+	auto texIt = mTextureTable.find(clientTexID);
+	if( texIt != mTextureTable.end() )
+	{
+		if( texIt->second ){
+			NetImguiServer::App::ReleaseTexture(*texIt->second, *this);
+		}
+		mTextureTable.erase(texIt);
+		mEvictedTextures.insert(clientTexID);
+
+		// DrawData referencing it can't be rendered anymore (RenderTarget keeps its last output until next DrawFrame)
+		NetImgui::Internal::netImguiDeleteSafe(mpImguiDrawData);
+		NetImgui::Internal::netImguiDeleteSafe(mpPendingDrawData);
 	}
 }
 
@@ -171,11 +548,18 @@ void Client::Initialize()
 	mLastUpdateTime			= std::chrono::steady_clock::now() - std::chrono::hours(1);
 	mLastDrawFrame			= std::chrono::steady_clock::now();
 	mLastIncomingComTime	= std::chrono::steady_clock::now();
+	mLastVisibleTime		= std::chrono::steady_clock::now();
 	mLastDrawFrameIndex		= 0;
 	mStatsIndex				= 0;
 	mStatsRcvdBps			= 0;
 	mStatsSentBps			= 0;
 	mStatsDrawElapsedMs		= 0.f;
+	mStatsDeltaHitPct		= 0.f;
+	mStatsVideoFrames		= 0;
+	mStatsVideoBytesRcvd	= 0;
+	mStatsVideoBytesRaw		= 0;
+	mStatsVideoDecodeMs		= 0.f;
+	mStatsVideoLatencyMs	= 0.f;
 	mStatsDataRcvd			= 0;
 	mStatsDataSent			= 0;
 	mStatsDataRcvdPrev		= 0;
@@ -185,8 +569,15 @@ void Client::Initialize()
 	mBGSettings				= NetImgui::Internal::CmdBackground();	// Assign background default value, until we receive first update from client
 	mPendingRcv				= NetImgui::Internal::PendingCom();
 	mPendingSend			= NetImgui::Internal::PendingCom();
+	mPendingTextureBytes		= 0;
+	mPendingTextureRcvCount		= 0;
+	mPendingTextureDoneCount	= 0;
+	mTextureHistoryIndex		= 0;
+	mTextureHistory.assign(kTextureHistoryCount, TexUpdateInfo());
 	NetImgui::Internal::netImguiDeleteSafe(mpImguiDrawData);
-	NetImgui::Internal::netImguiDeleteSafe(mpFrameDrawPrev);
+	ReleaseFrameDrawRefs();
+	mFrameIndexAck			= 0;
+	mbKeyFrameRequested		= false;
 }
 
 void Client::Uninitialize()
@@ -196,10 +587,48 @@ void Client::Uninitialize()
 	for( auto serverTexIt : mTextureTable )
 	{
 		if( serverTexIt.second ){
-			serverTexIt.second->MarkForDelete();
+			NetImguiServer::App::ReleaseTexture(*serverTexIt.second, *this);
 		}
 	}
 	mTextureTable.clear();
+	mEvictedTextures.clear();
+	{
+		std::lock_guard<std::mutex> guard(mPendingTextureRequestLock);
+		mPendingTextureRequests.clear();
+	}
+
+	// Wait on worker thread decoding this client textures, and release the remaining ones
+	{
+		std::lock_guard<std::mutex> guardDecode(mDecodeTextureLock);
+		std::lock_guard<std::mutex> guardTextures(mReceivedTexturesLock);
+		for(ReceivedTexture& receivedTexture : mReceivedTextures){
+			NetImgui::Internal::netImguiDelete(receivedTexture.mpCmdTexture);
+		}
+		mReceivedTextures.clear();
+		mVideoReferences.clear();
+		mbVideoReferences = false;
+	}
+
+	// Release per connection buffers, so unused client slots stay lightweight
+	TakePendingTextureCmds();
+	while( mpPendingTextureFirst ){
+		NetImgui::Internal::CmdTexture* pTextureCmd	= mpPendingTextureFirst;
+		mpPendingTextureFirst						= pTextureCmd->mpNext;
+		NetImgui::Internal::netImguiDelete(pTextureCmd);
+	}
+	mpPendingTextureLast = nullptr;
+	std::vector<TexUpdateInfo>().swap(mTextureHistory);
+
+	// Wait on worker thread decoding this client frames, and release the remaining ones
+	{
+		std::lock_guard<std::mutex> guardDecode(mDecodeLock);
+		std::lock_guard<std::mutex> guardFrames(mReceivedFramesLock);
+		for(ReceivedFrame& receivedFrame : mReceivedFrames){
+			NetImgui::Internal::netImguiDeleteSafe(receivedFrame.mpCmdDrawFrame);
+		}
+		mReceivedFrames.clear();
+		ReleaseFrameDrawRefs();
+	}
 
 	mPendingImguiDrawDataIn.Free();
 	mPendingBackgroundIn.Free();
@@ -207,20 +636,21 @@ void Client::Uninitialize()
 	mPendingClipboardOut.Free();
 
 	NetImgui::Internal::netImguiDeleteSafe(mpImguiDrawData);
-	NetImgui::Internal::netImguiDeleteSafe(mpFrameDrawPrev);
+	NetImgui::Internal::netImguiDeleteSafe(mpPendingDrawData);
+	NetImgui::Internal::netImguiDeleteSafe(mpTextureWaitDrawData);
 	if (mpBGContext) {
 		ImGui::DestroyContext(mpBGContext);
 		mpBGContext	= nullptr;
 	}
 
 	mInfoName[0]					= 0;
-	mClientIndex					= 0;
 	mClientConfigID					= NetImguiServer::Config::Client::kInvalidRuntimeID;
 	mbCompressionSkipOncePending	= false;
 	mbDisconnectPending				= false;
 	mbIsConnected					= false;
-	mbIsFree						= true;
 	mBGNeedUpdate					= true;
+	mRenderDirtyFrames				= 1;
+	ReleaseIndex(mClientIndex);
 }
 
 // Used on communication thread to let main thread know this client resources should be deleted
@@ -229,21 +659,54 @@ void Client::Release()
 	mbIsReleased = true;
 }
 
-bool Client::Startup(uint32_t clientCountMax)
+//=================================================================================================
+// Allocate a new block of client slots and add them to the free list
+// Note: 'gClientListLock' must be held by caller
+//=================================================================================================
+static bool AllocateClientBlock()
+{
+	uint32_t countMax	= gClientCountMax;
+	uint32_t blockIndex	= countMax / kClientBlockSize;
+	if( blockIndex >= kClientBlockCountMax ){
+		return false;
+	}
+
+	Client* pBlock = new Client[kClientBlockSize];
+	for(uint32_t i(0); i < kClientBlockSize; ++i){
+		pBlock[i].mClientIndex = countMax + i;
+	}
+	gpClientBlocks[blockIndex] = pBlock;
+	gClientCountMax = countMax + kClientBlockSize;	// Only publish new slot count once block is assigned
+
+	// Added in reverse order, so lower indices get used first
+	for(uint32_t i(kClientBlockSize); i > 0; --i){
+		gClientFreeList.push_back(countMax + i - 1);
+	}
+	return true;
+}
+
+bool Client::Startup(uint32_t clientCountReserve)
 {
-	gClientCountMax = clientCountMax;
-	gpClients		= new Client[clientCountMax];
-	return gpClients != nullptr;
+	std::lock_guard<std::mutex> guard(gClientListLock);
+	while( gClientCountMax < clientCountReserve ){
+		if( !AllocateClientBlock() ){
+			return false;
+		}
+	}
+	return true;
 }
 
 void Client::Shutdown()
 {
-	gClientCountMax = 0;
-	if (gpClients)
+	uint32_t blockCount = gClientCountMax.exchange(0) / kClientBlockSize;
+	for(uint32_t i(0); i < blockCount; ++i)
 	{
-		delete[] gpClients;
-		gpClients = nullptr;
+		Client* pBlock = gpClientBlocks[i].exchange(nullptr);
+		delete[] pBlock;
 	}
+	gClientFreeList.clear();
+	gClientActiveList.clear();
+	gClientActiveListMain.clear();
 }
 
 uint32_t Client::GetCountMax()
@@ -253,20 +716,53 @@ uint32_t Client::GetCountMax()
 
 Client& Client::Get(uint32_t index)
 {
-	bool bValid = gpClients && index < gClientCountMax;
+	bool bValid = index < gClientCountMax;
 	static Client sInvalidClient;
 	assert( bValid );
-	return bValid ? gpClients[index] : sInvalidClient;
+	return bValid ? gpClientBlocks[index / kClientBlockSize].load()[index % kClientBlockSize] : sInvalidClient;
 }
 
 uint32_t Client::GetFreeIndex()
 {
-	for (uint32_t i(0); i < gClientCountMax; ++i)
+	std::lock_guard<std::mutex> guard(gClientListLock);
+	if( gClientFreeList.empty() && !AllocateClientBlock() ){
+		return kInvalidClient;
+	}
+	uint32_t freeIndex = gClientFreeList.back();
+	gClientFreeList.pop_back();
+	gClientActiveList.push_back(freeIndex);
+	Get(freeIndex).mbIsFree = false;
+	return freeIndex;
+}
+
+void Client::ReleaseIndex(uint32_t index)
+{
+	std::lock_guard<std::mutex> guard(gClientListLock);
+	if( index < gClientCountMax && Get(index).mbIsFree.exchange(true) == false )
 	{
-		if( gpClients[i].mbIsFree.exchange(false) == true )
-			return i;
+		gClientFreeList.push_back(index);
+		int activeIdx = gClientActiveList.find_index(index);
+		if( activeIdx >= 0 ){
+			ImSwap(gClientActiveList[activeIdx], gClientActiveList.back());
+			gClientActiveList.pop_back();
+		}
 	}
-	return kInvalidClient;
+}
+
+void Client::UpdateActiveList()
+{
+	std::lock_guard<std::mutex> guard(gClientListLock);
+	gClientActiveListMain = gClientActiveList;
+}
+
+uint32_t Client::GetActiveCount()
+{
+	return static_cast<uint32_t>(gClientActiveListMain.size());
+}
+
+Client& Client::GetActive(uint32_t activeIndex)
+{
+	return Get(gClientActiveListMain[static_cast<int>(activeIndex)]);
 }
 
 //=================================================================================================
@@ -281,10 +777,25 @@ NetImguiImDrawData*	Client::GetImguiDrawData(ImTextureID EmtpyTextureID)
 		mpImguiDrawData		= mpPendingDrawData;
 		mLastDrawFrameIndex	= mpImguiDrawData->mFrameIndex;
 		mpPendingDrawData	= nullptr;
+		MarkRenderDirty();
 	}
 
 	// Check if a new frame has been added. If yes, then take ownership of it.
-	NetImguiImDrawData* pPendingDrawData = mPendingImguiDrawDataIn.Release();
+	NetImguiImDrawData* pNewDrawData = mPendingImguiDrawDataIn.Release();
+	if( pNewDrawData )
+	{
+		NetImgui::Internal::netImguiDeleteSafe( mpTextureWaitDrawData );
+		mpTextureWaitDrawData = pNewDrawData;
+	}
+
+	// Only use the new frame once all textures commands received before it have been processed
+	NetImguiImDrawData* pPendingDrawData = nullptr;
+	if( mpTextureWaitDrawData && mpTextureWaitDrawData->mTextureCmdCount <= mPendingTextureDoneCount )
+	{
+		pPendingDrawData		= mpTextureWaitDrawData;
+		mpTextureWaitDrawData	= nullptr;
+	}
+
 	if( pPendingDrawData )
 	{
 		bool bHasPendingTextureUpdate(false);
@@ -305,9 +816,20 @@ NetImguiImDrawData*	Client::GetImguiDrawData(ImTextureID EmtpyTextureID)
 				{
 					ImTextureData* texData 			= &texIt->second->mTexData;
 					serverTexRef 					= texData->GetTexRef();
-					texIt->second->mLastFrameUsed 	= pPendingDrawData->mFrameIndex; // Needed to know when it is safe to release the texture resource
+					if( texIt->second->mOwnerClientIndex == static_cast<int32_t>(mClientIndex) ){
+						texIt->second->mLastFrameUsed = pPendingDrawData->mFrameIndex; // Needed to know when it is safe to release the texture resource
+					}
 					bHasPendingTextureUpdate		|= texData->Status != ImTextureStatus::ImTextureStatus_OK;
 				}
+				// Texture released to lower memory usage, ask client to send it again
+				else if( texIt == mTextureTable.end() && mEvictedTextures.erase(clientTexUserID) != 0 )
+				{
+					std::lock_guard<std::mutex> guard(mPendingTextureRequestLock);
+					mPendingTextureRequests.push_back({clientTexUserID, 0});
+				}
+				if( texIt == mTextureTable.end() || !texIt->second ){
+					pPendingDrawData->mMissingTextures.push_back({clientTexUserID, drawIdx});
+				}
 				pCmdList->CmdBuffer[drawIdx].TexRef	= serverTexRef;
 			}
 		}
@@ -325,22 +847,57 @@ NetImguiImDrawData*	Client::GetImguiDrawData(ImTextureID EmtpyTextureID)
 			NetImgui::Internal::netImguiDeleteSafe( mpImguiDrawData );
 			mpImguiDrawData		= pPendingDrawData;
 			mLastDrawFrameIndex	= mpImguiDrawData->mFrameIndex;
+			MarkRenderDirty();
 		}
 	}
-	
+
+	// Textures received after the displayed DrawData was converted (requested again), can now be used
+	if( mbMissingTexturesReceived ){
+		mbMissingTexturesReceived = (mpImguiDrawData && ResolveMissingTextures(*mpImguiDrawData)) || (mpPendingDrawData && ResolveMissingTextures(*mpPendingDrawData));
+	}
 	return mpImguiDrawData;
 }
 
 //=================================================================================================
-// Create a new Dear Imgui DrawData ready to be submitted for rendering
+// Update the draws using the empty texture, with their texture received since.
+// Without it, the client content keeps missing these textures until its next DrawFrame
 //=================================================================================================
-void Client::ProcessCmdDrawFrame(NetImgui::Internal::CmdDrawFrame* pCmdDrawFrame)
+bool Client::ResolveMissingTextures(NetImguiImDrawData& drawData)
 {
-	constexpr float kPosRangeMin	= static_cast<float>(NetImgui::Internal::ImguiVert::kPosRange_Min);
-	constexpr float kPosRangeMax	= static_cast<float>(NetImgui::Internal::ImguiVert::kPosRange_Max);
-	constexpr float kUVRangeMin		= static_cast<float>(NetImgui::Internal::ImguiVert::kUvRange_Min);
-	constexpr float kUVRangeMax		= static_cast<float>(NetImgui::Internal::ImguiVert::kUvRange_Max);
+	bool bWaitingCreation(false);
+	for(size_t i(0); i<drawData.mMissingTextures.size(); )
+	{
+		auto texIt = mTextureTable.find(drawData.mMissingTextures[i].first);
+		if( texIt != mTextureTable.end() && texIt->second )
+		{
+			// Texture not created by the backend yet, try again next frame
+			if( texIt->second->mTexData.Status != ImTextureStatus::ImTextureStatus_OK ){
+				bWaitingCreation = true;
+				++i;
+				continue;
+			}
+			if( texIt->second->mOwnerClientIndex == static_cast<int32_t>(mClientIndex) ){
+				texIt->second->mLastFrameUsed = drawData.mFrameIndex;
+			}
+			drawData.mCommandList.CmdBuffer[drawData.mMissingTextures[i].second].TexRef = texIt->second->mTexData.GetTexRef(); // All draws are in the same CmdList
+			drawData.mMissingTextures[i] = drawData.mMissingTextures.back();
+			drawData.mMissingTextures.pop_back();
+			if( &drawData == mpImguiDrawData ){
+				MarkRenderDirty();
+			}
+		}
+		else {
+			++i;
+		}
+	}
+	return bWaitingCreation;
+}
 
+//=================================================================================================
+// Create a new Dear Imgui DrawData ready to be submitted for rendering
+//=================================================================================================
+void Client::ProcessCmdDrawFrame(NetImgui::Internal::CmdDrawFrame* pCmdDrawFrame, uint64_t textureCmdCount)
+{
 	if (!pCmdDrawFrame){
 		return;
 	}
@@ -348,6 +905,7 @@ void Client::ProcessCmdDrawFrame(NetImgui::Internal::CmdDrawFrame* pCmdDrawFrame
 
 	NetImguiImDrawData* pDrawData	= NetImgui::Internal::netImguiNew<NetImguiImDrawData>();
 	pDrawData->mFrameIndex			= pCmdDrawFrame->mFrameIndex;
+	pDrawData->mTextureCmdCount		= textureCmdCount;
 	pDrawData->Valid				= true;
     pDrawData->TotalVtxCount		= static_cast<int>(pCmdDrawFrame->mTotalVerticeCount);
 	pDrawData->TotalIdxCount		= static_cast<int>(pCmdDrawFrame->mTotalIndiceCount);
@@ -367,6 +925,7 @@ void Client::ProcessCmdDrawFrame(NetImgui::Internal::CmdDrawFrame* pCmdDrawFrame
 	if( pCmdDrawFrame->mTotalDrawCount != 0 )
 	{
 		uint32_t indexOffset(0), vertexOffset(0);
+		std::vector<NetImgui::Internal::ImguiDraw> draws;
 		ImDrawIdx* pIndexDst			= &pCmdList->IdxBuffer[0];
 		ImDrawVert* pVertexDst			= &pCmdList->VtxBuffer[0];
 		ImDrawCmd* pCommandDst			= &pCmdList->CmdBuffer[0];
@@ -374,32 +933,16 @@ void Client::ProcessCmdDrawFrame(NetImgui::Internal::CmdDrawFrame* pCmdDrawFrame
 		for(uint32_t i(0); i<pCmdDrawFrame->mDrawGroupCount; ++i){
 			const NetImgui::Internal::ImguiDrawGroup& drawGroup = pCmdDrawFrame->mpDrawGroups[i];
 				
-			// Copy/Convert Indices from network command to Dear ImGui indices format
-			const uint16_t* pIndices = reinterpret_cast<const uint16_t*>(drawGroup.mpIndices.Get());
-			if (drawGroup.mBytePerIndex == sizeof(ImDrawIdx))
-			{
-				memcpy(pIndexDst, pIndices, drawGroup.mIndiceCount*sizeof(ImDrawIdx));
-			}
-			else
-			{
-				for (uint32_t indexIdx(0); indexIdx < drawGroup.mIndiceCount; ++indexIdx){
-					pIndexDst[indexIdx] = static_cast<ImDrawIdx>(pIndices[indexIdx]);
-				}
-			}
-
-			// Convert the Vertices from network command to Dear Imgui Format
-			const NetImgui::Internal::ImguiVert* pVertexSrc = drawGroup.mpVertices.Get();
-			for (uint32_t vtxIdx(0); vtxIdx < drawGroup.mVerticeCount; ++vtxIdx)
-			{
-				pVertexDst[vtxIdx].pos.x				= (static_cast<float>(pVertexSrc[vtxIdx].mPos[0]) * (kPosRangeMax - kPosRangeMin)) / static_cast<float>(0xFFFF) + kPosRangeMin + drawGroup.mReferenceCoord[0];
-				pVertexDst[vtxIdx].pos.y				= (static_cast<float>(pVertexSrc[vtxIdx].mPos[1]) * (kPosRangeMax - kPosRangeMin)) / static_cast<float>(0xFFFF) + kPosRangeMin + drawGroup.mReferenceCoord[1];
-				pVertexDst[vtxIdx].uv.x					= (static_cast<float>(pVertexSrc[vtxIdx].mUV[0]) * (kUVRangeMax - kUVRangeMin)) / static_cast<float>(0xFFFF) + kUVRangeMin;
-				pVertexDst[vtxIdx].uv.y					= (static_cast<float>(pVertexSrc[vtxIdx].mUV[1]) * (kUVRangeMax - kUVRangeMin)) / static_cast<float>(0xFFFF) + kUVRangeMin;
-				pVertexDst[vtxIdx].col					= pVertexSrc[vtxIdx].mColor;
+			// Convert the Vertices, Indices and Draws from network command to Dear Imgui Format
+			draws.resize(drawGroup.mDrawCount);
+			if( !NetImgui::Internal::DecodeDrawGroupGeometry(drawGroup, pVertexDst, pIndexDst) || !NetImgui::Internal::DecodeDrawGroupDraws(drawGroup, draws.data()) ){
+				// Invalid data, should never happen. Ignore this frame and disconnect
+				NetImgui::Internal::netImguiDelete(pDrawData);
+				NetImgui::Internal::netImguiDelete(pCmdDrawFrame);
+				mbDisconnectPending = true;
+				return;
 			}
-
-			// Convert the Draws from network command to Dear Imgui Format
-			const NetImgui::Internal::ImguiDraw* pDrawSrc = drawGroup.mpDraws.Get();
+			const NetImgui::Internal::ImguiDraw* pDrawSrc = draws.data();
 			for(uint32_t drawIdx(0); drawIdx<drawGroup.mDrawCount; ++drawIdx)
 			{
 				pCommandDst[drawIdx].ClipRect.x			= pDrawSrc[drawIdx].mClipRect[0];
@@ -421,10 +964,22 @@ void Client::ProcessCmdDrawFrame(NetImgui::Internal::CmdDrawFrame* pCmdDrawFrame
 			vertexOffset	+= drawGroup.mVerticeCount;
 		}
 	}
-	mpFrameDrawPrev	= pCmdDrawFrame;
+	mFrameDrawRefs.push_back(pCmdDrawFrame);
+	mFrameIndexAck	= pCmdDrawFrame->mFrameIndex;
 	mPendingImguiDrawDataIn.Assign(pDrawData);
 }
 
+//=================================================================================================
+// Release the DrawFrames kept as delta compression reference (worker thread or disconnected)
+//=================================================================================================
+void Client::ReleaseFrameDrawRefs()
+{
+	for(NetImgui::Internal::CmdDrawFrame* pCmdDrawFrame : mFrameDrawRefs){
+		NetImgui::Internal::netImguiDelete(pCmdDrawFrame);
+	}
+	mFrameDrawRefs.clear();
+}
+
 //=================================================================================================
 // Note: Caller must take ownership of item and delete the object
 //=================================================================================================
@@ -438,6 +993,19 @@ NetImgui::Internal::CmdClipboard* Client::TakePendingClipboard()
 	return mPendingClipboardOut.Release();
 }
 
+NetImgui::Internal::CmdTextureRequest* Client::TakePendingTextureRequest()
+{
+	std::lock_guard<std::mutex> guard(mPendingTextureRequestLock);
+	if( mPendingTextureRequests.empty() ){
+		return nullptr;
+	}
+	NetImgui::Internal::CmdTextureRequest* pCmdRequest	= NetImgui::Internal::netImguiNew<NetImgui::Internal::CmdTextureRequest>();
+	pCmdRequest->mTextureClientID						= mPendingTextureRequests.back().mTextureClientID;
+	pCmdRequest->mContentHash							= mPendingTextureRequests.back().mContentHash;
+	mPendingTextureRequests.pop_back();
+	return pCmdRequest;
+}
+
 //=================================================================================================
 // Capture current received Dear ImGui input, and forward it to the active client
 // Note:	Even if a client is not focused, we are still sending it the mouse position, 
@@ -500,6 +1068,7 @@ void Client::CaptureImguiInput()
 	pNewInput->mCompressionSkip		= mbCompressionSkipOncePending;
 	pNewInput->mFontDPIScaling		= 1.f;
 	pNewInput->mDesiredFps			= clientFPS;
+	pNewInput->mFrameIndexAck		= mFrameIndexAck;
 
 	if( config.mDPIScaleEnabled )
 	{
@@ -3,6 +3,8 @@
 #include <vector>
 #include <chrono>
 #include <unordered_map>
+#include <unordered_set>
+#include <mutex>
 #include <Private/NetImgui_CmdPackets.h>
 #include "NetImguiServer_App.h"
 
@@ -21,7 +23,9 @@ struct NetImguiImDrawData : ImDrawData
 {
 				NetImguiImDrawData();
 	ImDrawList	mCommandList;
-	uint64_t 	mFrameIndex = 0;
+	uint64_t 	mFrameIndex			= 0;
+	uint64_t	mTextureCmdCount	= 0;	// Number of texture commands received before this frame (must be processed before displaying it)
+	std::vector<std::pair<uint64_t, int>> mMissingTextures;	// Draws using the empty texture (client TextureID, draw index), until their texture is received
 };
 
 //=================================================================================================
@@ -29,12 +33,36 @@ struct NetImguiImDrawData : ImDrawData
 //=================================================================================================
 struct Client
 {	
-	static constexpr uint32_t kInvalidClient = static_cast<uint32_t>(-1);
+	static constexpr uint32_t kInvalidClient		= static_cast<uint32_t>(-1);
+	static constexpr uint32_t kTextureHistoryCount	= 256;						// Size of texture commands debug history (allocated on connection)
+	static constexpr size_t kFrameDrawRefsMax		= 8;						// Decoded DrawFrames kept as potential delta compression reference
+	static constexpr uint64_t kPendingTextureBytesMax = 256ull * 1024ull * 1024ull;	// Stop receiving new commands while more than this amount of texture data waits to be processed
 	using ExchPtrInput		= NetImgui::Internal::ExchangePtr<NetImgui::Internal::CmdInput>;
 	using ExchPtrClipboard	= NetImgui::Internal::ExchangePtr<NetImgui::Internal::CmdClipboard>;
 	using ExchPtrBackground = NetImgui::Internal::ExchangePtr<NetImgui::Internal::CmdBackground>;
 	using ExchPtrImguiDraw	= NetImgui::Internal::ExchangePtr<NetImguiImDrawData>;
 	using TextureTable		= std::unordered_map<uint64_t, App::ServerTexture*>;
+	struct ReceivedFrame
+	{
+		NetImgui::Internal::CmdDrawFrame*		mpCmdDrawFrame;
+		uint64_t								mTextureCmdCount;	// Number of texture commands received before this frame
+	};
+	struct ReceivedTexture
+	{
+		NetImgui::Internal::CmdTexture*			mpCmdTexture;
+		std::chrono::steady_clock::time_point	mReceivedTime;
+	};
+	struct VideoReference
+	{
+		uint16_t								mWidth;
+		uint16_t								mHeight;
+		std::vector<uint8_t>					mPixels;			// RGBA8 content of the entire texture, as last decoded
+	};
+	struct TextureRequest
+	{
+		uint64_t								mTextureClientID;
+		uint64_t								mContentHash;
+	};
 	struct TexUpdateInfo
 	{
 		uint64_t ClientId;
@@ -61,20 +89,36 @@ struct Client
 	bool										IsValid()const;
 												
 	void										ReceiveTexture(NetImgui::Internal::CmdTexture*);
+	void										AddPendingTextureCmd(NetImgui::Internal::CmdTexture*);
+	static void									DecodeTextureJob(void* pClient);	// Worker thread job decoding received compressed textures of a client
+	NetImgui::Internal::CmdTexture*				DecodeTextureVideo(const ReceivedTexture& receivedTexture);	// Worker thread decoding of an inter-frame compressed texture (nullptr when invalid)
 	void										ReceiveDrawFrame(NetImgui::Internal::CmdDrawFrame*);
-	void										ProcessCmdDrawFrame(NetImgui::Internal::CmdDrawFrame* pCmdDrawFrame);
+	static void									DecodeDrawFrameJob(void* pClient);	// Worker thread job decoding received DrawFrames of a client
+	void										DecodeDrawFrame(const ReceivedFrame& receivedFrame);
+	void										ProcessCmdDrawFrame(NetImgui::Internal::CmdDrawFrame* pCmdDrawFrame, uint64_t textureCmdCount);
+	void										ReleaseFrameDrawRefs();
 	NetImguiImDrawData*							GetImguiDrawData(ImTextureID EmtpyTextureID);	// Get current active Imgui draw data
+	bool										ResolveMissingTextures(NetImguiImDrawData& drawData);	// Use textures received after the DrawData was converted (true when some are still waiting on their creation)
 		                                    	
 	void										CaptureImguiInput();
 	NetImgui::Internal::CmdInput*				TakePendingInput();
 	NetImgui::Internal::CmdClipboard*			TakePendingClipboard();
+	NetImgui::Internal::CmdTextureRequest*		TakePendingTextureRequest();
+	void										TakePendingTextureCmds();
 	void										ProcessPendingTextureCmds();
+	void										EvictTexture(uint64_t clientTexID);	// Release a texture to lower memory usage, it's requested again from client when needed
+	inline bool									IsPendingTextureFull()const { return mPendingTextureBytes > kPendingTextureBytesMax; }
+	inline void									MarkRenderDirty(uint8_t frameCount=1){ mRenderDirtyFrames = mRenderDirtyFrames > frameCount ? mRenderDirtyFrames : frameCount; }
 
-	static bool									Startup(uint32_t clientCountMax);
+	static bool									Startup(uint32_t clientCountReserve);
 	static void									Shutdown();
-	static uint32_t								GetCountMax();
-	static uint32_t								GetFreeIndex();
+	static uint32_t								GetCountMax();						// Number of allocated client slots (grows with number of simultaneous connections)
+	static uint32_t								GetFreeIndex();						// Reserve an unused client slot (allocating more slots when needed)
+	static void									ReleaseIndex(uint32_t index);		// Return a client slot to the unused list
 	static Client&								Get(uint32_t index);
+	static void									UpdateActiveList();					// Refresh the list of used client slots iterated by the main thread (once per frame)
+	static uint32_t								GetActiveCount();					// Number of client slots in use (main thread only)
+	static Client&								GetActive(uint32_t activeIndex);	// Access client slot in use (main thread only)
 
 	void*										mpHAL_AreaRT			= nullptr;
 	ImTextureData								mHAL_AreaTexture;
@@ -93,28 +137,47 @@ struct Client
 
 	NetImguiImDrawData*							mpImguiDrawData			= nullptr;	//!< Current Imgui Data that this client is the owner of
 	NetImguiImDrawData*							mpPendingDrawData		= nullptr;	//!< Pending Imgui Data that has to have 1 frame display delay, to avoid issue with textures with pending updates
-	NetImgui::Internal::CmdDrawFrame*			mpFrameDrawPrev			= nullptr;	//!< Last valid DrawDrame (used by com thread, to uncompress data)
+	NetImguiImDrawData*							mpTextureWaitDrawData	= nullptr;	//!< Received Imgui Data waiting on its texture commands to be processed, before it can be used
+	std::vector<NetImgui::Internal::CmdDrawFrame*>	mFrameDrawRefs;					//!< Decoded DrawFrames the client can use as delta compression reference (used by worker thread, oldest first)
+	std::atomic_uint64_t						mFrameIndexAck;						//!< Last decoded DrawFrame, acknowledged to the client as usable for delta compression
+	bool										mbKeyFrameRequested		= false;	//!< Waiting on an uncompressed DrawFrame after failing to decode one (used by worker thread)
+	std::vector<ReceivedFrame>					mReceivedFrames;					//!< DrawFrames received by com thread, waiting to be decoded by a worker thread (oldest first)
+	std::mutex									mReceivedFramesLock;				//!< Protects 'mReceivedFrames' access
+	std::mutex									mDecodeLock;						//!< Held while a worker thread is decoding DrawFrames of this client (one at a time, since frames are delta compressed)
+	std::vector<ReceivedTexture>				mReceivedTextures;					//!< Texture commands received by com thread, waiting on a compressed texture to be decoded by a worker thread (oldest first)
+	std::mutex									mReceivedTexturesLock;				//!< Protects 'mReceivedTextures' access
+	std::mutex									mDecodeTextureLock;					//!< Held while a worker thread is decoding textures of this client (one at a time, to preserve ordering)
+	std::unordered_map<uint64_t, VideoReference>	mVideoReferences;					//!< Previous content of textures received with inter-frame compression, needed to decode the next one (protected by 'mDecodeTextureLock')
+	std::atomic_bool							mbVideoReferences;					//!< True when 'mVideoReferences' isn't empty. All texture commands then go through the worker thread, letting it release the invalidated references
 	TextureTable								mTextureTable;						//!< Table matching client TextureUserID to textures allocated on Server for it
+	std::unordered_set<uint64_t>				mEvictedTextures;					//!< Textures released to stay under the memory budget, that client must send again when needed
+	bool										mbMissingTexturesReceived = false;	//!< A texture was created since last checking the draws using the empty texture in 'mpImguiDrawData'
+	std::vector<TextureRequest>					mPendingTextureRequests;			//!< Textures received without pixel data that we don't have (or evicted), waiting to be requested to client
+	std::mutex									mPendingTextureRequestLock;			//!< Protects 'mPendingTextureRequests' access
 	ExchPtrImguiDraw							mPendingImguiDrawDataIn;			//!< Pending received Imgui DrawData, waiting to be taken ownership of
 	ExchPtrBackground							mPendingBackgroundIn;				//!< Background settings received and waiting to update client setting
 	ExchPtrClipboard							mPendingClipboardIn;				//!< Clipboard received from Client and waiting to be processed on Server
 	ExchPtrInput								mPendingInputOut;					//!< Input command waiting to be sent out to client
 	ExchPtrClipboard							mPendingClipboardOut;				//!< Clipboard command waiting to be sent out to client
 	std::vector<ImWchar>						mPendingInputChars;					//!< Captured Imgui characters input waiting to be added to new InputCmd
-	NetImgui::Internal::CmdTexture*				mpPendingTextures[1024]	= {};		//!< Textures commands waiting to be processed in main update loop
-	std::atomic_uint64_t						mPendingTextureReadIndex;
-	std::atomic_uint64_t						mPendingTextureWriteIndex;
+	std::atomic<NetImgui::Internal::CmdTexture*>	mpPendingTextureIn;					//!< Lock-free list of received textures commands (most recent first), pushed by com thread
+	NetImgui::Internal::CmdTexture*				mpPendingTextureFirst	= nullptr;	//!< Textures commands waiting to be processed in main update loop (oldest first, main thread only)
+	NetImgui::Internal::CmdTexture*				mpPendingTextureLast	= nullptr;	//!< Last entry of 'mpPendingTextureFirst' list
+	std::atomic_uint64_t						mPendingTextureBytes;				//!< Size of texture commands received but not processed yet (used for backpressure)
+	std::atomic_uint64_t						mPendingTextureRcvCount;			//!< Number of texture commands received since connected
+	uint64_t									mPendingTextureDoneCount= 0;		//!< Number of texture commands processed since connected
 	bool										mbIsVisible				= false;	//!< If currently shown
 	bool										mbIsActive				= false;	//!< Is the current active window (will receive input, only one is true at a time)
 	bool										mbIsReleased			= false;	//!< If released in com thread and main thread should delete resources
 	bool										mbIsConnected			= false;	//!< If connected to a remote client. Set to false in Unitialize, after mIsRelease is set to unload resources
 	std::atomic_bool							mbIsFree;							//!< If available to use for a new connected client	
-	std::atomic_bool							mbCompressionSkipOncePending;		//!< When we detect invalid previous DrawFrame command, cancel compression for 1 frame, to get good data
+	std::atomic_bool							mbCompressionSkipOncePending;		//!< When we detect a DrawFrame compressed against a reference we don't have, request an uncompressed one (keyframe)
 	std::atomic_bool							mbDisconnectPending;				//!< Terminate Client/Server coms
 	std::chrono::steady_clock::time_point		mConnectedTime;						//!< When the connection was established with this remote client
 	std::chrono::steady_clock::time_point		mLastUpdateTime;					//!< When the client last send a content refresh request
 	std::chrono::steady_clock::time_point		mLastDrawFrame;						//!< When we last receive a new drawframe commant
 	std::chrono::steady_clock::time_point 		mLastIncomingComTime;				//!< When we last received a valid command from client (to detect timeout)
+	std::chrono::steady_clock::time_point		mLastVisibleTime;					//!< When the client window was last displayed (textures of clients hidden the longest are evicted first)
 	uint32_t									mClientConfigID			= 0;		//!< ID of ClientConfig that connected (if connection came from our list of ClientConfigs)	
 	uint32_t									mClientIndex			= 0;		//!< Entry idx into table of connected clients
 	uint64_t									mStatsDataRcvd			= 0;		//!< Current amount of Bytes received since connected
@@ -125,18 +188,25 @@ struct Client
 	uint32_t									mStatsRcvdBps			= 0;		//!< Average Bytes received per second
 	uint32_t									mStatsSentBps			= 0;		//!< Average Bytes sent per second
 	float										mStatsDrawElapsedMs		= 0.f;		//!< Average milliseconds between 2 draw requests
+	std::atomic<float>							mStatsDeltaHitPct;					//!< Average percentage of DrawGroups found in their reference frame, by delta compressed DrawFrames (updated by worker thread)
+	std::atomic_uint64_t						mStatsVideoFrames;					//!< Number of textures received with inter-frame compression
+	std::atomic_uint64_t						mStatsVideoBytesRcvd;				//!< Size of textures received with inter-frame compression
+	std::atomic_uint64_t						mStatsVideoBytesRaw;				//!< Uncompressed size of textures received with inter-frame compression
+	std::atomic<float>							mStatsVideoDecodeMs;				//!< Average milliseconds spent decoding an inter-frame compressed texture (updated by worker thread)
+	std::atomic<float>							mStatsVideoLatencyMs;				//!< Average milliseconds between receiving an inter-frame compressed texture, and it being ready for the main thread (updated by worker thread)
 	uint32_t									mStatsIndex				= 0;
 	float										mMousePos[2]			= {0,0};
 	float										mMouseWheelPos[2]		= {0,0};
 	ImGuiMouseCursor							mMouseCursor			= ImGuiMouseCursor_None;	// Last mosue cursor remote client requested
 	ImGuiContext*								mpBGContext				= nullptr;					// Special Imgui Context used to render the background (only updated when needed)
 	bool										mBGNeedUpdate			= true;						// Let engine know that we should regenerate the background draw commands
+	uint8_t										mRenderDirtyFrames		= 1;						// Number of upcoming frames where the RenderTarget content must be regenerated (new drawdata, background, resize, texture update)
 	NetImgui::Internal::Network::SocketInfo*	mpSocket				= nullptr;	//!< Socket used for communications 
 	NetImgui::Internal::CmdBackground			mBGSettings;						//!< Settings for client background drawing settings
 	NetImgui::Internal::CmdPendingRead 			mCmdPendingRead;					//!< Used to get info on the next incoming command from Client
 	NetImgui::Internal::PendingCom 				mPendingRcv;						//!< Data being currently received from Client
 	NetImgui::Internal::PendingCom 				mPendingSend;						//!< Data being currently sent to Client
-	TexUpdateInfo								mTextureHistory[256]	= {};		//!< Keeps track of texture changes (for debug info)
+	std::vector<TexUpdateInfo>					mTextureHistory;					//!< Keeps track of texture changes (for debug info, allocated on connection)
 	uint32_t 									mTextureHistoryIndex	= 0;
 	uint64_t									mLastDrawFrameIndex		= 0;		//!< Last frame index of valid drawdata drawn
 };
@@ -8,6 +8,7 @@
 #include "NetImguiServer_RemoteClient.h"
 #include "NetImguiServer_Config.h"
 #include "NetImguiServer_Network.h"
+#include "NetImguiServer_Worker.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "../ThirdParty/stb_image.h"
@@ -32,6 +33,7 @@ static uint32_t							gPopup_ConfirmDisconnect_ClientIdx	= kClientRemoteInvalid;
 static uint32_t							gPopup_ConfirmDelete_ConfigIdx		= NetImguiServer::Config::Client::kInvalidRuntimeID;
 static bool								gPopup_AboutNetImgui_Show			= false;
 static bool								gPopup_ServerConfig_Show			= false;
+static bool								gPopup_TextureBenchmark_Show		= false;
 static NetImguiServer::Config::Client*	gPopup_ClientConfig_pConfig			= nullptr;
 
 //=================================================================================================
@@ -105,6 +107,14 @@ void ClientInfoTooltip(const RemoteClient::Client& Client)
 		ImGui::TextUnformatted("Fps");		ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": %04.1f", Client.mbIsVisible ? 1000.f/Client.mStatsDrawElapsedMs : 0.f);
 		ImGui::TextUnformatted("Data");		ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": (Rx) %7i KB/s \t(Tx) %7i KB/s", Client.mStatsRcvdBps/1024, Client.mStatsSentBps/1024);
 		ImGui::NewLine();					ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": (Rx) %7i %s   \t(Tx) %7i %s", static_cast<int>(rxData), kDataSizeUnits[rxUnitIdx], static_cast<int>(txData), kDataSizeUnits[txUnitIdx]);
+		if( NetImguiServer::Config::Server::sCompressionEnable ){
+			ImGui::TextUnformatted("Delta");ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": %04.1f%% of draw groups matched", Client.mStatsDeltaHitPct.load());
+		}
+		if( Client.mStatsVideoFrames > 0 ){
+			float videoRatio = Client.mStatsVideoBytesRaw > 0 ? 100.f * static_cast<float>(Client.mStatsVideoBytesRcvd) / static_cast<float>(Client.mStatsVideoBytesRaw) : 0.f;
+			ImGui::TextUnformatted("Video");ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": %i frames (%.1f%% of raw size)", static_cast<int>(Client.mStatsVideoFrames), videoRatio);
+			ImGui::NewLine();				ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": Decode %.2f ms \tLatency %.2f ms", Client.mStatsVideoDecodeMs.load(), Client.mStatsVideoLatencyMs.load());
+		}
 		ImGui::EndTooltip();
 	}
 }
@@ -213,6 +223,154 @@ void Popup_AboutNetImgui()
 	}
 }
 
+//=================================================================================================
+// Measure the texture transport compression formats, on typical content
+//	- Font atlas	: Server own Dear ImGui font texture
+//	- Screenshot	: Generated desktop like image (gradient background, windows, text lines)
+//=================================================================================================
+struct TextureBenchmarkResult
+{
+	const char*				mContentName	= nullptr;
+	NetImgui::eTexFormat	mFormat			= NetImgui::eTexFormat::kTexFmt_Invalid;
+	size_t					mRawSize		= 0;
+	size_t					mEncodedSize	= 0;
+	float					mEncodeMBps		= 0.f;
+	float					mDecodeMBps		= 0.f;
+	int						mErrorMax		= 0;
+};
+
+static void TextureBenchmark_Measure(const char* contentName, NetImgui::eTexFormat format, const uint8_t* pPixels, uint32_t width, uint32_t height, std::vector<TextureBenchmarkResult>& resultsOut)
+{
+	constexpr int kRepeatCount				= 4;
+	const NetImgui::eTexFormat formatRaw	= NetImgui::Internal::GetTextureFormatUncompressed(format);
+	const size_t rawSize					= NetImgui::GetTexture_BytePerImage(formatRaw, width, height);
+	const size_t encodeSizeMax				= NetImgui::Internal::GetTextureEncodeSizeMax(format, width, height);
+	std::vector<uint8_t> encoded(encodeSizeMax);
+	std::vector<uint8_t> decoded(rawSize);
+
+	TextureBenchmarkResult result;
+	result.mContentName	= contentName;
+	result.mFormat		= format;
+	result.mRawSize		= rawSize;
+	auto timeStart		= std::chrono::steady_clock::now();
+	for(int i(0); i < kRepeatCount; ++i){
+		result.mEncodedSize = NetImgui::Internal::TextureEncode(format, pPixels, width, height, encoded.data(), encodeSizeMax);
+	}
+	auto timeEncoded	= std::chrono::steady_clock::now();
+	for(int i(0); i < kRepeatCount; ++i){
+		NetImgui::Internal::TextureDecode(format, encoded.data(), result.mEncodedSize, width, height, decoded.data());
+	}
+	auto timeDecoded	= std::chrono::steady_clock::now();
+
+	const float totalMB	= static_cast<float>(rawSize * kRepeatCount) / (1024.f*1024.f);
+	result.mEncodeMBps	= totalMB * 1000000.f / std::max(1.f, static_cast<float>(std::chrono::duration_cast<std::chrono::microseconds>(timeEncoded - timeStart).count()));
+	result.mDecodeMBps	= totalMB * 1000000.f / std::max(1.f, static_cast<float>(std::chrono::duration_cast<std::chrono::microseconds>(timeDecoded - timeEncoded).count()));
+	for(size_t i(0); i < rawSize; ++i){
+		result.mErrorMax = std::max(result.mErrorMax, std::abs(static_cast<int>(decoded[i]) - static_cast<int>(pPixels[i])));
+	}
+	resultsOut.push_back(result);
+}
+
+static void TextureBenchmark_Run(std::vector<TextureBenchmarkResult>& resultsOut)
+{
+	resultsOut.clear();
+
+	// Font atlas, tested as both Alpha8 and RGBA8 content
+	const ImTextureData* pFontTex = ImGui::GetIO().Fonts->TexData;
+	if( pFontTex && pFontTex->Pixels )
+	{
+		const uint32_t width	= static_cast<uint32_t>(pFontTex->Width);
+		const uint32_t height	= static_cast<uint32_t>(pFontTex->Height);
+		const size_t count		= static_cast<size_t>(width) * height;
+		std::vector<uint8_t> pixelsA8(count);
+		std::vector<uint8_t> pixelsRGBA8(count*4);
+		for(size_t i(0); i < count; ++i)
+		{
+			const uint8_t alpha		= pFontTex->Format == ImTextureFormat_Alpha8 ? pFontTex->Pixels[i] : pFontTex->Pixels[i*4+3];
+			pixelsA8[i]				= alpha;
+			pixelsRGBA8[i*4+0]		= 0xFF;
+			pixelsRGBA8[i*4+1]		= 0xFF;
+			pixelsRGBA8[i*4+2]		= 0xFF;
+			pixelsRGBA8[i*4+3]		= alpha;
+		}
+		TextureBenchmark_Measure("Font Atlas", NetImgui::eTexFormat::kTexFmtA8_LZ, pixelsA8.data(), width, height, resultsOut);
+		TextureBenchmark_Measure("Font Atlas", NetImgui::eTexFormat::kTexFmtRGBA8_LZ, pixelsRGBA8.data(), width, height, resultsOut);
+		TextureBenchmark_Measure("Font Atlas", NetImgui::eTexFormat::kTexFmtRGBA8_Block, pixelsRGBA8.data(), width, height, resultsOut);
+	}
+
+	// Screenshot like content
+	{
+		constexpr uint32_t width(1920), height(1080);
+		std::vector<uint8_t> pixels(static_cast<size_t>(width)*height*4);
+		uint32_t seed(12345);
+		for(uint32_t y(0); y < height; ++y)
+		{
+			for(uint32_t x(0); x < width; ++x)
+			{
+				uint8_t* pPixel		= &pixels[(static_cast<size_t>(y)*width + x)*4];
+				const bool inWindow	= ((x / 480) % 2) != ((y / 360) % 2) && (x % 480) > 16 && (y % 360) > 16;
+				const bool inTitle	= inWindow && (y % 360) < 40;
+				const bool inText	= inWindow && !inTitle && (y % 20) < 12 && (x % 480) < 48 + (y*7 % 300);
+				seed				= seed * 1103515245u + 12345u;
+				const bool isGlyph	= inText && ((seed >> 16) % 3) != 0;
+				pPixel[0]			= isGlyph ? 230 : inTitle ? 41  : inWindow ? 36 : static_cast<uint8_t>(40 + x * 60 / width);
+				pPixel[1]			= isGlyph ? 230 : inTitle ? 74  : inWindow ? 36 : static_cast<uint8_t>(60 + y * 80 / height);
+				pPixel[2]			= isGlyph ? 230 : inTitle ? 122 : inWindow ? 40 : static_cast<uint8_t>(120 + (x + y) * 60 / (width + height));
+				pPixel[3]			= 0xFF;
+			}
+		}
+		TextureBenchmark_Measure("Screenshot", NetImgui::eTexFormat::kTexFmtRGBA8_LZ, pixels.data(), width, height, resultsOut);
+		TextureBenchmark_Measure("Screenshot", NetImgui::eTexFormat::kTexFmtRGBA8_Block, pixels.data(), width, height, resultsOut);
+	}
+}
+
+void Popup_TextureBenchmark()
+{
+	static std::vector<TextureBenchmarkResult> sResults;
+	if( gPopup_TextureBenchmark_Show )
+	{
+		ImGuiWindowClass windowClass;
+		windowClass.ViewportFlagsOverrideSet = ImGuiViewportFlags_TopMost;
+		ImGui::SetNextWindowClass(&windowClass);
+		ImGui::OpenPopup("Texture Compression Benchmark");
+		if (ImGui::BeginPopupModal("Texture Compression Benchmark", &gPopup_TextureBenchmark_Show, ImGuiWindowFlags_AlwaysAutoResize))
+		{
+			if( ImGui::Button("Run") ){
+				TextureBenchmark_Run(sResults);
+			}
+			ImGui::SameLine(); ImGui::TextColored(kColorContent, "(Single threaded, results vary with content)");
+			if( !sResults.empty() && ImGui::BeginTable("Results", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit) )
+			{
+				const char* kFormatNames[] = {"RGBA8", "A8", "Custom", "RGBA8 LZ", "A8 LZ", "RGBA8 Block"};
+				ImGui::TableSetupColumn("Content");
+				ImGui::TableSetupColumn("Format");
+				ImGui::TableSetupColumn("Size (KB)");
+				ImGui::TableSetupColumn("Ratio");
+				ImGui::TableSetupColumn("Encode (MB/s)");
+				ImGui::TableSetupColumn("Decode (MB/s)");
+				ImGui::TableSetupColumn("Error Max");
+				ImGui::TableHeadersRow();
+				for(const TextureBenchmarkResult& result : sResults)
+				{
+					ImGui::TableNextColumn(); ImGui::TextUnformatted(result.mContentName);
+					ImGui::TableNextColumn(); ImGui::TextUnformatted(result.mFormat < IM_ARRAYSIZE(kFormatNames) ? kFormatNames[result.mFormat] : "?");
+					ImGui::TableNextColumn(); ImGui::Text("%i -> %i", static_cast<int>(result.mRawSize/1024), static_cast<int>(result.mEncodedSize/1024));
+					ImGui::TableNextColumn(); ImGui::Text("%.1f : 1", result.mEncodedSize > 0 ? static_cast<float>(result.mRawSize)/static_cast<float>(result.mEncodedSize) : 0.f);
+					ImGui::TableNextColumn(); ImGui::Text("%.0f", result.mEncodeMBps);
+					ImGui::TableNextColumn(); ImGui::Text("%.0f", result.mDecodeMBps);
+					ImGui::TableNextColumn(); ImGui::Text("%i", result.mErrorMax);
+				}
+				ImGui::EndTable();
+			}
+			ImGui::Separator();
+			if( ImGui::Button("Close", ImVec2(ImGui::GetContentRegionAvail().x, 0)) || ImGui::IsKeyPressed(ImGuiKey_Escape) ){
+				gPopup_TextureBenchmark_Show = false;
+			}
+			ImGui::EndPopup();
+		}
+	}
+}
+
 //=================================================================================================
 // Edit the Server configuration
 //=================================================================================================
@@ -222,6 +380,7 @@ void Popup_ServerConfig()
 	static float sEditRefreshFPSActive		= 0;
 	static float sEditRefreshFPSInactive	= 0;
 	static bool sEditCompressionEnable		= true;
+	static int sEditTextureBudgetMB			= 0;
 	static int sEditServerFontSize			= 0;
 	static float sSavedDPIScalePourcentage	= 0.f;
 	if( gPopup_ServerConfig_Show )
@@ -231,6 +390,7 @@ void Popup_ServerConfig()
 			sEditRefreshFPSActive		= NetImguiServer::Config::Server::sRefreshFPSActive;
 			sEditRefreshFPSInactive		= NetImguiServer::Config::Server::sRefreshFPSInactive;
 			sEditCompressionEnable		= NetImguiServer::Config::Server::sCompressionEnable;
+			sEditTextureBudgetMB		= static_cast<int>(NetImguiServer::Config::Server::sTextureBudgetMB);
 			sEditServerFontSize			= (int)NetImguiServer::Config::Server::sFontSize;
 			sSavedDPIScalePourcentage	= NetImguiServer::Config::Server::sDPIScaleRatio;
 		}
@@ -295,6 +455,17 @@ void Popup_ServerConfig()
 									"Note: This setting can be overridden on client side.");
 			}
 
+			// --- Texture Budget ---
+			if( ImGui::InputInt("Texture Budget (MB)", &sEditTextureBudgetMB, 16, 256) ){
+				sEditTextureBudgetMB = std::max<int>(0, sEditTextureBudgetMB);
+			}
+			if( ImGui::IsItemHovered() ){
+				ImGui::SetTooltip(	"Texture memory used by the Server is kept under this value, by releasing\n"
+									"the least recently used textures of hidden clients (0 for unlimited).\n"
+									"These textures are requested again from their client when needed.\n"
+									"Currently used : %.1f MB", static_cast<double>(NetImguiServer::App::GetTextureMemoryUsage())/(1024.*1024.));
+			}
+
 			// --- Save/Cancel ---
 			ImGui::NewLine();
 			ImGui::Separator();
@@ -308,6 +479,7 @@ void Popup_ServerConfig()
 				NetImguiServer::Config::Server::sRefreshFPSActive	= sEditRefreshFPSActive;
 				NetImguiServer::Config::Server::sRefreshFPSInactive	= sEditRefreshFPSInactive;
 				NetImguiServer::Config::Server::sCompressionEnable	= sEditCompressionEnable;
+				NetImguiServer::Config::Server::sTextureBudgetMB	= static_cast<uint32_t>(sEditTextureBudgetMB);
 				NetImguiServer::Config::Server::sFontSize			= (float)sEditServerFontSize;
 				NetImguiServer::Config::Client::SaveAll();
 				gPopup_ServerConfig_Show = false;
@@ -534,12 +706,12 @@ void DrawImguiContent_Clients()
 	// Display each connected client window
 	//---------------------------------------------------------------------------------------------
 	bool hasConnection(false), hasClipboardSet(false);
-	for(uint32_t i(0); i<RemoteClient::Client::GetCountMax(); ++i)
+	for(uint32_t i(0); i<RemoteClient::Client::GetActiveCount(); ++i)
 	{
-		RemoteClient::Client& client = RemoteClient::Client::Get(i);
+		RemoteClient::Client& client = RemoteClient::Client::GetActive(i);
 		if( client.mbIsConnected )
 		{
-			ImGui::PushID(i);
+			ImGui::PushID(static_cast<int>(client.mClientIndex));
 			ImGui::SetNextWindowBgAlpha(1.0);
 			ImGui::SetNextWindowDockID(gMainDockID, ImGuiCond_Once);
 			bool bOpened		= true;
@@ -618,9 +790,9 @@ void DrawImguiContent_Clients()
 			}
 		}
 		// Forward Server Clipboard content to Clients
-		for(uint32_t i(0); i<RemoteClient::Client::GetCountMax(); ++i)
+		for(uint32_t i(0); i<RemoteClient::Client::GetActiveCount(); ++i)
 		{
-			RemoteClient::Client& client = RemoteClient::Client::Get(i);
+			RemoteClient::Client& client = RemoteClient::Client::GetActive(i);
 			const bool bFirstTimeDisplay = client.mpHAL_AreaRT == nullptr;
 			if( client.mbIsConnected  && (clipboardContentUpdated  || bFirstTimeDisplay) ){
 				NetImgui::Internal::CmdClipboard* pClipboard = NetImgui::Internal::CmdClipboard::Create(&sSavedServerClipboard[0]);
@@ -806,11 +978,11 @@ void DrawImguiContent_MainMenu_Clients()
 
 		// First, display all connected clients without a config
 		ImGui::PushID("Connected");
-		for (uint32_t i(0); i < RemoteClient::Client::GetCountMax(); ++i)
+		for(uint32_t i(0); i<RemoteClient::Client::GetActiveCount(); ++i)
 		{
-			RemoteClient::Client& client = RemoteClient::Client::Get(i);
+			RemoteClient::Client& client = RemoteClient::Client::GetActive(i);
 			if( client.mbIsConnected && client.mClientConfigID == NetImguiServer::Config::Client::kInvalidRuntimeID ){
-				ImGui::PushID(i);
+				ImGui::PushID(static_cast<int>(client.mClientIndex));
 				DrawImguiContent_MainMenu_Clients_Entry(&client, nullptr);
 				ImGui::PopID();
 				++connectedClient;
@@ -821,11 +993,11 @@ void DrawImguiContent_MainMenu_Clients()
 		// Next, display all connected clients with a config
 		NetImguiServer::Config::Client clientConfig;
 		ImGui::PushID("ConfigConnected");
-		for (uint32_t i(0); i < RemoteClient::Client::GetCountMax(); ++i)
+		for(uint32_t i(0); i<RemoteClient::Client::GetActiveCount(); ++i)
 		{
-			RemoteClient::Client& client = RemoteClient::Client::Get(i);
+			RemoteClient::Client& client = RemoteClient::Client::GetActive(i);
 			if( client.mbIsConnected && NetImguiServer::Config::Client::GetConfigByID(client.mClientConfigID, clientConfig) ){
-				ImGui::PushID(i);
+				ImGui::PushID(static_cast<int>(client.mClientIndex));
 				DrawImguiContent_MainMenu_Clients_Entry(&client, &clientConfig);
 				ImGui::PopID();
 				++connectedClient;
@@ -894,9 +1066,9 @@ void DrawImguiContent_MainMenu_Clients()
 void DrawImguiContent_MainMenu_Stats()
 {
 	uint32_t txKBs(0), rxKBs(0), connected(0);	
-	for(uint32_t i(0); i<RemoteClient::Client::GetCountMax(); ++i)
+	for(uint32_t i(0); i<RemoteClient::Client::GetActiveCount(); ++i)
 	{
-		RemoteClient::Client& client = RemoteClient::Client::Get(i);
+		RemoteClient::Client& client = RemoteClient::Client::GetActive(i);
 		txKBs		+= client.mbIsConnected ? client.mStatsSentBps/1024 : 0;
 		rxKBs		+= client.mbIsConnected ? client.mStatsRcvdBps/1024 : 0;
 		connected	+= client.mbIsConnected ? 1 : 0;
@@ -917,6 +1089,14 @@ void DrawImguiContent_MainMenu_Stats()
 			ImGui::TextUnformatted("Connections");		ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": %i", connected);
 			ImGui::TextUnformatted("Data Received");	ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": %i %s", static_cast<int>(rxData), kDataSizeUnits[rxUnitIdx]);
 			ImGui::TextUnformatted("Data Sent");		ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": %i %s", static_cast<int>(txData), kDataSizeUnits[txUnitIdx]);
+			
+			// DrawFrame and compressed texture decoding, done by worker threads
+			NetImguiServer::Worker::Stats workerStats = NetImguiServer::Worker::GetStats();
+			ImGui::Separator();
+			ImGui::TextUnformatted("Decode Workers");	ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": %i", static_cast<int>(workerStats.mThreadCount));
+			ImGui::TextUnformatted("Decode Rate");		ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": %.1f jobs/s", workerStats.mJobsPerSecond);
+			ImGui::TextUnformatted("Decode Latency");	ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": %.2f ms (%.2f ms processing)", workerStats.mLatencyMs, workerStats.mExecutionMs);
+			ImGui::TextUnformatted("Decode Pending");	ImGui::SameLine(width); ImGui::TextColored(kColorContent, ": %i", static_cast<int>(workerStats.mJobsPending));
 		}
 		ImGui::EndTooltip();
 	}
@@ -937,6 +1117,7 @@ void DrawImguiContent_MainMenu()
 		}
 		
 		gPopup_ServerConfig_Show	^= ImGui::MenuItem("Settings");
+		gPopup_TextureBenchmark_Show^= ImGui::MenuItem("Benchmark");
 		gPopup_AboutNetImgui_Show	^= ImGui::MenuItem("About");
 		DrawImguiContent_MainMenu_Stats();
 		ImGui::EndMainMenuBar();
@@ -959,6 +1140,7 @@ ImVec4 DrawImguiContent()
 	Popup_ClientConfigDelete();
 	Popup_ConfirmDisconnect();
 	Popup_AboutNetImgui();
+	Popup_TextureBenchmark();
 
 	DrawImguiContent_MainMenu();
 	DrawImguiContent_SetupDocking();
@@ -0,0 +1,135 @@
+#include "Private/NetImgui_WarningDisableStd.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "NetImguiServer_Worker.h"
+
+namespace NetImguiServer { namespace Worker
+{
+
+struct Job
+{
+	JobFunction								mpFunction	= nullptr;
+	void*									mpUserData	= nullptr;
+	std::chrono::steady_clock::time_point	mAddedTime;
+};
+
+static constexpr uint32_t						kThreadCountMax	= 8;
+static std::vector<std::thread>					gThreads;
+static std::deque<Job>							gJobs;
+static std::mutex								gJobsLock;
+static std::condition_variable					gJobsSignal;
+static bool										gbShutdown(false);
+
+// Stats, updated by worker threads after each job completion (protected by gStatsLock)
+static std::mutex								gStatsLock;
+static uint64_t									gStatsJobsDone(0);
+static uint64_t									gStatsWindowJobs(0);		// Jobs completed since start of current measuring window
+static std::chrono::steady_clock::time_point	gStatsWindowStart;
+static float									gStatsJobsPerSecond(0.f);
+static float									gStatsLatencyMs(0.f);
+static float									gStatsExecutionMs(0.f);
+
+//=================================================================================================
+// Keep processing queued jobs until shutdown
+//=================================================================================================
+static void WorkerThread()
+{
+	while( true )
+	{
+		Job job;
+		{
+			std::unique_lock<std::mutex> guard(gJobsLock);
+			gJobsSignal.wait(guard, []{ return gbShutdown || !gJobs.empty(); });
+			if( gJobs.empty() ){
+				return; // Shutdown requested and no work left
+			}
+			job = gJobs.front();
+			gJobs.pop_front();
+		}
+
+		auto timeStart	= std::chrono::steady_clock::now();
+		job.mpFunction(job.mpUserData);
+		auto timeEnd	= std::chrono::steady_clock::now();
+
+		constexpr float kHysteresis	= 0.05f; // Between 0 to 1.0
+		float latencyMs				= static_cast<float>(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - job.mAddedTime).count()) / 1000.f;
+		float executionMs			= static_cast<float>(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count()) / 1000.f;
+		std::lock_guard<std::mutex> guard(gStatsLock);
+		gStatsLatencyMs				= gStatsLatencyMs * (1.f-kHysteresis) + latencyMs * kHysteresis;
+		gStatsExecutionMs			= gStatsExecutionMs * (1.f-kHysteresis) + executionMs * kHysteresis;
+		gStatsJobsDone++;
+		gStatsWindowJobs++;
+		auto windowUs				= std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - gStatsWindowStart).count();
+		if( windowUs >= 1000000 ){
+			gStatsJobsPerSecond		= static_cast<float>(gStatsWindowJobs) * 1000000.f / static_cast<float>(windowUs);
+			gStatsWindowJobs		= 0;
+			gStatsWindowStart		= timeEnd;
+		}
+	}
+}
+
+bool Startup(uint32_t threadCount)
+{
+	if( threadCount == 0 ){
+		// Leave some cores to the main thread and the client com threads
+		uint32_t hardwareCount	= std::thread::hardware_concurrency();
+		threadCount				= std::max<uint32_t>(1u, std::min<uint32_t>(hardwareCount/2u, kThreadCountMax));
+	}
+
+	gbShutdown			= false;
+	gStatsWindowStart	= std::chrono::steady_clock::now();
+	for(uint32_t i(0); i < threadCount; ++i){
+		gThreads.emplace_back(WorkerThread);
+	}
+	return true;
+}
+
+void Shutdown()
+{
+	{
+		std::lock_guard<std::mutex> guard(gJobsLock);
+		gbShutdown = true;
+	}
+	gJobsSignal.notify_all();
+	for(std::thread& thread : gThreads){
+		thread.join();
+	}
+	gThreads.clear();
+}
+
+void AddJob(JobFunction pFunction, void* pUserData)
+{
+	{
+		std::lock_guard<std::mutex> guard(gJobsLock);
+		Job job;
+		job.mpFunction	= pFunction;
+		job.mpUserData	= pUserData;
+		job.mAddedTime	= std::chrono::steady_clock::now();
+		gJobs.push_back(job);
+	}
+	gJobsSignal.notify_one();
+}
+
+Stats GetStats()
+{
+	Stats stats;
+	{
+		std::lock_guard<std::mutex> guard(gJobsLock);
+		stats.mThreadCount	= static_cast<uint32_t>(gThreads.size());
+		stats.mJobsPending	= static_cast<uint32_t>(gJobs.size());
+	}
+	std::lock_guard<std::mutex> guard(gStatsLock);
+	bool bIdle				= std::chrono::steady_clock::now() - gStatsWindowStart > std::chrono::seconds(2); // No job completed recently
+	stats.mJobsDone			= gStatsJobsDone;
+	stats.mJobsPerSecond	= bIdle ? 0.f : gStatsJobsPerSecond;
+	stats.mLatencyMs		= gStatsLatencyMs;
+	stats.mExecutionMs		= gStatsExecutionMs;
+	return stats;
+}
+
+}} // namespace NetImguiServer { namespace Worker
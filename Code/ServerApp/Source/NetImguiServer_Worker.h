@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace NetImguiServer { namespace Worker
+{
+// Function executed on one of the worker threads
+using JobFunction = void(*)(void* pUserData);
+
+struct Stats
+{
+	uint32_t	mThreadCount	= 0;	// Number of worker threads in the pool
+	uint32_t	mJobsPending	= 0;	// Jobs waiting for an available worker
+	uint64_t	mJobsDone		= 0;	// Total number of jobs completed since start
+	float		mJobsPerSecond	= 0.f;	// Number of jobs completed per second (throughput)
+	float		mLatencyMs		= 0.f;	// Average time between a job being added and its completion
+	float		mExecutionMs	= 0.f;	// Average time spent running a job
+};
+
+// Start the worker threads (0 : size the pool from available hardware threads)
+bool Startup(uint32_t threadCount=0);
+
+// Wait on all jobs to complete and stop the worker threads
+void Shutdown();
+
+// Queue a job, executed by the first available worker thread
+void AddJob(JobFunction pFunction, void* pUserData);
+
+// Current worker pool stats
+Stats GetStats();
+
+}}
@@ -126,6 +126,24 @@ void HAL_DestroyRenderTarget(void*& pOutRT, ImTextureData& OutTexture)
 	}
 }
 
+//=================================================================================================
+// HAL IS TEXTURE FORMAT SUPPORTED
+// Only RGBA32 supported by the Sokol backend, Alpha8 textures are expanded to RGBA32 instead
+//=================================================================================================
+bool HAL_IsTextureFormatSupported(ImTextureFormat Format)
+{
+	return Format == ImTextureFormat_RGBA32;
+}
+
+//=================================================================================================
+// HAL UPDATE TEXTURE
+// Nothing to do, only RGBA32 textures are created (handled by Dear ImGui's backend)
+//=================================================================================================
+void HAL_UpdateTexture(ImTextureData& Texture)
+{
+	IM_UNUSED(Texture);
+}
+
 }} //namespace NetImguiServer { namespace App
 
 #endif // HAL_API_PLATFORM_SOKOL
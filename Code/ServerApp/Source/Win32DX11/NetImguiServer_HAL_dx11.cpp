@@ -184,6 +184,25 @@ void HAL_DestroyRenderTarget(void*& pOutRT, ImTextureData& OutTexture)
 	//-------------------------------------------------------------
 }
 
+//=================================================================================================
+// HAL IS TEXTURE FORMAT SUPPORTED
+// Backend pixel shader multiplies the vertex color with a RGBA texture sample. An Alpha8 texture
+// would return a black color, so they are expanded to RGBA32 instead
+//=================================================================================================
+bool HAL_IsTextureFormatSupported(ImTextureFormat Format)
+{
+	return Format == ImTextureFormat_RGBA32;
+}
+
+//=================================================================================================
+// HAL UPDATE TEXTURE
+// Nothing to do, only RGBA32 textures are created (handled by Dear ImGui's backend)
+//=================================================================================================
+void HAL_UpdateTexture(ImTextureData& Texture)
+{
+	IM_UNUSED(Texture);
+}
+
 }} //namespace NetImguiServer { namespace App
 
 #endif // HAL_API_PLATFORM_WIN32_DX11
\ No newline at end of file